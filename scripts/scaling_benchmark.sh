@@ -0,0 +1,56 @@
+#!/bin/bash
+# Καμπύλες κλιμάκωσης: δημιουργεί τυχαία instances με το instance_generator, εκτελεί τον solver σε καθένα και
+# γράφει σε CSV τον χρόνο, τη μέγιστη μνήμη (RSS), τα αμβλυγώνια και τα Steiner points της λύσης.
+#
+# Χρήση: scripts/scaling_benchmark.sh <build dir> [results.csv] [sizes...]
+# Μεταβλητές περιβάλλοντος: SEED (0), TIME_LIMIT_MS (60000), SOLVER_ARGS (επιπλέον ορίσματα του solver)
+# Τα αμβλυγώνια και τα Steiner points διαβάζονται από το αρχείο --metrics του solver (χρειάζεται python3).
+
+set -e
+
+if [ $# -lt 1 ]; then
+    echo "Usage: $0 <build dir> [results.csv] [sizes...]" >&2
+    exit 1
+fi
+
+BUILD_DIR=$1
+RESULTS=${2:-scaling.csv}
+shift $(( $# >= 2 ? 2 : 1 ))
+SIZES=${@:-10 100 1000 10000 100000 1000000}
+SEED=${SEED:-0}
+TIME_LIMIT_MS=${TIME_LIMIT_MS:-60000}
+
+GENERATOR="$BUILD_DIR/instance_generator"
+SOLVER="$BUILD_DIR/triangulation"
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+echo "instance,points,seed,wall_seconds,peak_rss_kb,obtuse,steiner,exit_code" > "$RESULTS"
+
+for SIZE in $SIZES; do
+    INSTANCE="$WORK_DIR/instance_$SIZE.json"
+    SOLUTION="$WORK_DIR/solution_$SIZE.json"
+    METRICS="$WORK_DIR/metrics_$SIZE.json"
+    rm -f "$METRICS"
+    "$GENERATOR" "$INSTANCE" --points "$SIZE" --seed "$SEED" > /dev/null
+
+    # Το /usr/bin/time γράφει τον χρόνο και τη μέγιστη μνήμη στο stats, η έξοδος του solver πάει στο log
+    set +e
+    /usr/bin/time -f "%e %M" -o "$WORK_DIR/stats" \
+        "$SOLVER" "$INSTANCE" "$SOLUTION" --time-limit "$TIME_LIMIT_MS" --no-draw --metrics "$METRICS" $SOLVER_ARGS > "$WORK_DIR/log" 2>&1
+    EXIT_CODE=$?
+    set -e
+
+    read WALL RSS < <(tail -n 1 "$WORK_DIR/stats")
+    # Χωρίς αρχείο metrics (π.χ. ο solver απέτυχε) οι στήλες μένουν κενές
+    OBTUSE=
+    STEINER=
+    if [ -f "$METRICS" ]; then
+        read OBTUSE STEINER < <(python3 -c 'import json, sys; m = json.load(open(sys.argv[1])); print(m["obtuse_count"], m["steiner_points"])' "$METRICS")
+    fi
+
+    echo "random_${SIZE}_${SEED},$SIZE,$SEED,$WALL,$RSS,$OBTUSE,$STEINER,$EXIT_CODE" >> "$RESULTS"
+    echo "n=$SIZE: ${WALL}s, ${RSS} KB, obtuse=$OBTUSE, steiner=$STEINER (exit $EXIT_CODE)"
+done
+
+echo "Results written to $RESULTS"
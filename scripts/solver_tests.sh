@@ -0,0 +1,84 @@
+#!/bin/bash
+# Έλεγχοι από άκρη σε άκρη για το ctest: ο solver τρέχει σε ένα instance και η λύση του περνά από το verify.
+#
+# Χρήση: scripts/solver_tests.sh <build dir> <case> [instance.json]
+#   solve     λύση του instance και verify
+#   generated λύση ενός μικρού τυχαίου instance (instance_generator) και verify
+#   replay    λύση με --operation-log, ξαναχτίσιμο με --replay και σύγκριση των δύο λύσεων
+#   resume    διακοπή με checkpoint, συνέχιση με --resume και verify
+# Μεταβλητές περιβάλλοντος: TIME_LIMIT_MS (5000). Η σύγκριση του replay χρειάζεται python3.
+
+set -e
+
+if [ $# -lt 2 ]; then
+    echo "Usage: $0 <build dir> solve|generated|replay|resume [instance.json]" >&2
+    exit 1
+fi
+
+BUILD_DIR=$1
+CASE=$2
+INSTANCE=$3
+TIME_LIMIT_MS=${TIME_LIMIT_MS:-5000}
+
+SOLVER="$BUILD_DIR/triangulation"
+VERIFY="$BUILD_DIR/verify"
+GENERATOR="$BUILD_DIR/instance_generator"
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+if [ -z "$INSTANCE" ]; then
+    INSTANCE="$WORK_DIR/instance.json"
+    "$GENERATOR" "$INSTANCE" --points 200 --constraints 4 --seed 1 > /dev/null
+fi
+
+solve() {
+    "$SOLVER" "$INSTANCE" "$@" --time-limit "$TIME_LIMIT_MS" --no-draw
+}
+
+case "$CASE" in
+solve | generated)
+    solve "$WORK_DIR/solution.json"
+    "$VERIFY" "$INSTANCE" "$WORK_DIR/solution.json"
+    ;;
+replay)
+    solve "$WORK_DIR/solution.json" --operation-log "$WORK_DIR/log.txt" --metrics "$WORK_DIR/metrics.json"
+    "$SOLVER" "$INSTANCE" "$WORK_DIR/replayed.json" --replay "$WORK_DIR/log.txt" --metrics "$WORK_DIR/replayed_metrics.json" --no-draw
+    "$VERIFY" "$INSTANCE" "$WORK_DIR/replayed.json"
+    # Η αρίθμηση των Steiner points εξαρτάται από τη σειρά των κορυφών στο CDT, οπότε συγκρίνουμε γεωμετρικά:
+    # τα ίδια Steiner points, οι ίδιες ακμές (ως ζεύγη σημείων) και τα ίδια αμβλυγώνια
+    python3 - "$INSTANCE" "$WORK_DIR/solution.json" "$WORK_DIR/replayed.json" "$WORK_DIR/metrics.json" "$WORK_DIR/replayed_metrics.json" <<'EOF'
+import json, sys
+from fractions import Fraction
+
+instance = json.load(open(sys.argv[1]))
+
+def geometry(filename):
+    solution = json.load(open(filename))
+    coordinate = lambda value: Fraction(str(value))
+    points = [(coordinate(x), coordinate(y)) for x, y in zip(instance["points_x"], instance["points_y"])]
+    steiner = [(coordinate(x), coordinate(y)) for x, y in zip(solution["steiner_points_x"], solution["steiner_points_y"])]
+    points += steiner
+    edges = {tuple(sorted((points[a], points[b]))) for a, b in solution["edges"]}
+    return sorted(steiner), edges
+
+original, replayed = geometry(sys.argv[2]), geometry(sys.argv[3])
+obtuse = [json.load(open(name))["obtuse_count"] for name in sys.argv[4:6]]
+if original != replayed or obtuse[0] != obtuse[1]:
+    sys.exit("The replayed solution differs from the original (obtuse %d vs %d)." % (obtuse[0], obtuse[1]))
+print("Replay matches the original solution")
+EOF
+    ;;
+resume)
+    solve "$WORK_DIR/interrupted.json" --checkpoint "$WORK_DIR/checkpoint.json" --checkpoint-interval 0
+    if [ ! -f "$WORK_DIR/checkpoint.json" ]; then
+        echo "No checkpoint was written." >&2
+        exit 1
+    fi
+    solve "$WORK_DIR/solution.json" --resume "$WORK_DIR/checkpoint.json"
+    "$VERIFY" "$INSTANCE" "$WORK_DIR/solution.json"
+    ;;
+*)
+    echo "Unknown case '$CASE'." >&2
+    exit 1
+    ;;
+esac
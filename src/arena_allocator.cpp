@@ -0,0 +1,95 @@
+#include "arena_allocator.h"
+#include <vector>
+
+// Κλάσεις μεγέθους από 64 bytes έως 64 MB. Μεγαλύτερα μπλοκ πηγαίνουν κατευθείαν στο heap.
+static const int min_class_bits = 6;
+static const int class_count = 21;
+// Ελεύθερα μπλοκ που κρατά κάθε κλάση, ώστε ένα CDT που μεγάλωσε μία φορά να μη δεσμεύει μνήμη για πάντα
+static const size_t max_cached_blocks = 256;
+
+// Οι λίστες ελεύθερων μπλοκ ενός νήματος. Στο τέλος του νήματος τα μπλοκ επιστρέφουν στο heap.
+struct ThreadArena
+{
+    vector<void *> free_blocks[class_count];
+
+    ~ThreadArena();
+
+    void release()
+    {
+        for (vector<void *> &blocks : free_blocks)
+        {
+            for (void *p : blocks)
+            {
+                ::operator delete(p);
+            }
+            blocks.clear();
+        }
+    }
+};
+
+static thread_local ThreadArena arena;
+// Μετά την καταστροφή της arena (στο τέλος του νήματος) οι δεσμεύσεις πηγαίνουν κατευθείαν στο heap
+static thread_local bool arena_destroyed = false;
+
+// Η κλάση του μεγέθους bytes, ή -1 αν είναι μεγαλύτερο από την τελευταία κλάση
+static int size_class(size_t bytes)
+{
+    int c = 0;
+    while (c < class_count && ((size_t)1 << (c + min_class_bits)) < bytes)
+    {
+        c++;
+    }
+    return c < class_count ? c : -1;
+}
+
+ThreadArena::~ThreadArena()
+{
+    release();
+    arena_destroyed = true;
+}
+
+void *ArenaPool::allocate(size_t bytes)
+{
+    if (arena_destroyed)
+        return ::operator new(bytes);
+    int c = size_class(bytes);
+    void *p;
+    if (c >= 0 && !arena.free_blocks[c].empty())
+    {
+        p = arena.free_blocks[c].back();
+        arena.free_blocks[c].pop_back();
+        return p;
+    }
+    return ::operator new(c >= 0 ? (size_t)1 << (c + min_class_bits) : bytes);
+}
+
+// Ένα μπλοκ μπορεί να ελευθερωθεί από άλλο νήμα από αυτό που το δέσμευσε (π.χ. αντίγραφα CDT που επιστρέφουν
+// τα νήματα του portfolio). Τότε απλώς περνά στη λίστα του νήματος που το ελευθερώνει.
+void ArenaPool::deallocate(void *p, size_t bytes)
+{
+    if (!p)
+        return;
+    int c = size_class(bytes);
+    if (!arena_destroyed && c >= 0 && arena.free_blocks[c].size() < max_cached_blocks)
+        arena.free_blocks[c].push_back(p);
+    else
+        ::operator delete(p);
+}
+
+void ArenaPool::release()
+{
+    if (!arena_destroyed)
+        arena.release();
+}
+
+size_t ArenaPool::cached_bytes()
+{
+    size_t total = 0;
+    if (arena_destroyed)
+        return 0;
+    for (int c = 0; c < class_count; ++c)
+    {
+        total += arena.free_blocks[c].size() << (c + min_class_bits);
+    }
+    return total;
+}
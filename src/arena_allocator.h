@@ -0,0 +1,109 @@
+#ifndef ARENA_ALLOCATOR_H
+#define ARENA_ALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+using namespace std;
+
+// Pool μνήμης ανά νήμα για τα containers της CGAL (κορυφές και όψεις των CDT). Τα μπλοκ στρογγυλεύονται σε
+// κλάσεις μεγέθους (δυνάμεις του 2) και όταν ελευθερώνονται μένουν στη λίστα της κλάσης τους στο νήμα, ώστε τα
+// δοκιμαστικά CDT της αξιολόγησης να ξαναχρησιμοποιούν την ίδια μνήμη χωρίς να περνούν από το κοινό heap.
+// Ενεργοποιείται με -DTRIANGULATION_ARENA (option TRIANGULATION_ARENA στο CMake) μέσω του CGAL_ALLOCATOR.
+class ArenaPool
+{
+public:
+    static void *allocate(size_t bytes);
+    static void deallocate(void *p, size_t bytes);
+
+    // Επιστρέφει στο heap όλα τα ελεύθερα μπλοκ που κρατά το τρέχον νήμα (reset της arena)
+    static void release();
+
+    // Bytes σε ελεύθερα μπλοκ που κρατά το τρέχον νήμα
+    static size_t cached_bytes();
+};
+
+template <class T>
+class ArenaAllocator
+{
+public:
+    typedef T value_type;
+    typedef T *pointer;
+    typedef const T *const_pointer;
+    typedef T &reference;
+    typedef const T &const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    template <class U>
+    struct rebind
+    {
+        typedef ArenaAllocator<U> other;
+    };
+
+    ArenaAllocator() {}
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U> &) {}
+
+    pointer address(reference x) const
+    {
+        return &x;
+    }
+
+    const_pointer address(const_reference x) const
+    {
+        return &x;
+    }
+
+    pointer allocate(size_type n, const void * = 0)
+    {
+        return static_cast<pointer>(ArenaPool::allocate(n * sizeof(T)));
+    }
+
+    void deallocate(pointer p, size_type n)
+    {
+        ArenaPool::deallocate(p, n * sizeof(T));
+    }
+
+    size_type max_size() const
+    {
+        return size_type(-1) / sizeof(T);
+    }
+
+    template <class U, class... Args>
+    void construct(U *p, Args &&...args)
+    {
+        ::new ((void *)p) U(std::forward<Args>(args)...);
+    }
+
+    template <class U>
+    void destroy(U *p)
+    {
+        p->~U();
+    }
+};
+
+// Όλα τα ArenaAllocator μοιράζονται τον ίδιο pool, οπότε ό,τι δεσμεύει το ένα μπορεί να το ελευθερώσει το άλλο
+template <class T, class U>
+bool operator==(const ArenaAllocator<T> &, const ArenaAllocator<U> &)
+{
+    return true;
+}
+
+template <class T, class U>
+bool operator!=(const ArenaAllocator<T> &, const ArenaAllocator<U> &)
+{
+    return false;
+}
+
+// Το CGAL_ALLOCATOR πρέπει να οριστεί πριν από το πρώτο header της CGAL, αλλιώς κάποια αρχεία θα έβλεπαν
+// διαφορετικό τύπο CDT
+#ifdef TRIANGULATION_ARENA
+#ifdef CGAL_MEMORY_H
+#error "arena_allocator.h must be included before any CGAL header"
+#endif
+#define CGAL_ALLOCATOR(T) ArenaAllocator<T>
+#endif
+
+#endif // ARENA_ALLOCATOR_H
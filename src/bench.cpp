@@ -0,0 +1,251 @@
+#include "triangulation_internal.h"
+#include "json.hpp"
+#include <CGAL/convex_hull_2.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <functional>
+#include <memory>
+#include <set>
+#include <cstdlib>
+
+using json = nlohmann::json;
+
+// Micro-benchmarks για τα βασικά κομμάτια της τριγωνοποίησης (predicates, καταμέτρηση, αντίγραφα, εισαγωγή,
+// στρατηγικές). Κάθε benchmark εκτελείται για κάθε μέγεθος τυχαίου instance και τα αποτελέσματα γράφονται σε JSON.
+//
+// Χρήση: triangulation_bench [results.json] [--sizes 100,1000,10000] [--min-time ms] [--seed n]
+
+struct BenchResult
+{
+    string name;
+    int size;
+    long long iterations;
+    double ns_per_op;
+};
+
+// Για να μη σβήνει ο compiler τους υπολογισμούς των benchmarks
+static volatile long long sink = 0;
+
+typedef chrono::steady_clock Clock;
+
+// Ένα batch επιστρέφει τον χρόνο του σε ns (χωρίς την προετοιμασία) και προσθέτει στο ops τις λειτουργίες που εκτέλεσε
+typedef function<double(long long &)> Batch;
+
+// Εκτελεί batches μέχρι ο μετρημένος χρόνος να ξεπεράσει το min_time_ms
+static BenchResult run_benchmark(const string &name, int size, double min_time_ms, const Batch &batch)
+{
+    double elapsed_ns = 0;
+    long long ops = 0;
+    while (elapsed_ns < min_time_ms * 1e6)
+    {
+        elapsed_ns += batch(ops);
+    }
+    BenchResult result = {name, size, ops, ops > 0 ? elapsed_ns / ops : 0.0};
+    cout << name << " (n=" << size << "): " << result.ns_per_op << " ns/op, " << ops << " iterations" << endl;
+    return result;
+}
+
+// Batch που χρονομετρεί n κλήσεις του body(i), με το i να συνεχίζει από batch σε batch
+static Batch repeat(long long n, function<void(long long)> body)
+{
+    auto next = make_shared<long long>(0);
+    return [=](long long &ops)
+    {
+        auto start = Clock::now();
+        for (long long k = 0; k < n; ++k)
+        {
+            body((*next)++);
+        }
+        ops += n;
+        return (double)chrono::duration_cast<chrono::nanoseconds>(Clock::now() - start).count();
+    };
+}
+
+// Τυχαίο instance με size σημεία (ακέραιες συντεταγμένες) και περιοχή το κυρτό τους περίβλημα
+static void make_instance(int size, mt19937 &rng, CDT &cdt, Polygon_2 &region_boundary)
+{
+    uniform_int_distribution<int> coordinate(0, 10 * size);
+    set<Point> points;
+    while ((int)points.size() < size)
+    {
+        points.insert(Point(coordinate(rng), coordinate(rng)));
+    }
+    cdt.insert(points.begin(), points.end());
+    CGAL::convex_hull_2(points.begin(), points.end(), back_inserter(region_boundary));
+}
+
+static vector<int> parse_sizes(const string &text)
+{
+    vector<int> sizes;
+    stringstream stream(text);
+    string item;
+    while (getline(stream, item, ','))
+    {
+        if (atoi(item.c_str()) > 0)
+            sizes.push_back(atoi(item.c_str()));
+    }
+    return sizes;
+}
+
+int main(int argc, char **argv)
+{
+    string output = "bench.json";
+    vector<int> sizes = {100, 1000, 10000};
+    double min_time_ms = 200;
+    unsigned seed = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        if (arg == "--sizes" && i + 1 < argc)
+            sizes = parse_sizes(argv[++i]);
+        else if (arg == "--min-time" && i + 1 < argc)
+            min_time_ms = atof(argv[++i]);
+        else if (arg == "--seed" && i + 1 < argc)
+            seed = strtoul(argv[++i], nullptr, 10);
+        else if (!arg.empty() && arg[0] != '-')
+            output = arg;
+        else
+        {
+            cerr << "Usage: " << argv[0] << " [results.json] [--sizes 100,1000,10000] [--min-time ms] [--seed n]" << endl;
+            return 1;
+        }
+    }
+
+    vector<BenchResult> results;
+    for (int size : sizes)
+    {
+        mt19937 rng(seed);
+        CDT cdt;
+        Polygon_2 region_boundary;
+        make_instance(size, rng, cdt, region_boundary);
+
+        vector<Face_handle> obtuse_faces = find_obtuse_faces(cdt);
+        vector<Point> corners;
+        for (auto fit = cdt.finite_faces_begin(); fit != cdt.finite_faces_end(); ++fit)
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                corners.push_back(fit->vertex(i)->point());
+            }
+        }
+        // Σημεία για τις εισαγωγές, εκτός πλέγματος ώστε να μη συμπίπτουν με κορυφές
+        vector<Point> insertions;
+        uniform_real_distribution<double> coordinate(0.5, 10 * size - 0.5);
+        for (int i = 0; i < 4096; ++i)
+        {
+            insertions.push_back(Point(coordinate(rng) + 0.25, coordinate(rng) + 0.25));
+        }
+
+        // Με πολύ λίγα σημεία δεν υπάρχει κανένα πεπερασμένο τρίγωνο
+        if (!corners.empty())
+        {
+            results.push_back(run_benchmark("is_obtuse_angle", size, min_time_ms, repeat(1 << 16, [&](long long i)
+            {
+                size_t k = 3 * (i % (corners.size() / 3));
+                sink += is_obtuse_angle(corners[k], corners[k + 1], corners[k + 2]);
+            })));
+        }
+
+        results.push_back(run_benchmark("count_Obtuse_Angles", size, min_time_ms, repeat(1, [&](long long)
+        {
+            sink += count_Obtuse_Angles(cdt);
+        })));
+
+        MeshMirror mesh;
+        results.push_back(run_benchmark("mesh_mirror_build", size, min_time_ms, repeat(1, [&](long long)
+        {
+            mesh.build(cdt, false);
+            sink += mesh.obtuse_count();
+        })));
+
+        results.push_back(run_benchmark("mesh_mirror_compact", size, min_time_ms, repeat(1, [&](long long)
+        {
+            mesh.compact();
+            sink += mesh.obtuse_count();
+        })));
+
+        results.push_back(run_benchmark("mesh_mirror_obtuse_faces", size, min_time_ms, repeat(1, [&](long long)
+        {
+            sink += mesh.obtuse_faces().size();
+        })));
+
+        results.push_back(run_benchmark("cdt_copy", size, min_time_ms, repeat(1, [&](long long)
+        {
+            CDT copy = cdt;
+            sink += copy.number_of_vertices();
+        })));
+
+        // Οι εισαγωγές γίνονται σε αντίγραφο που ανανεώνεται εκτός χρονομέτρησης
+        size_t next_insertion = 0;
+        results.push_back(run_benchmark("insert", size, min_time_ms, [&](long long &ops)
+        {
+            CDT work = cdt;
+            long long n = min<long long>(size, 256);
+            auto start = Clock::now();
+            for (long long k = 0; k < n; ++k)
+            {
+                work.insert(insertions[next_insertion++ % insertions.size()]);
+            }
+            ops += n;
+            return (double)chrono::duration_cast<chrono::nanoseconds>(Clock::now() - start).count();
+        }));
+
+        // Το ίδιο με ενημέρωση του MeshMirror μετά από κάθε εισαγωγή
+        results.push_back(run_benchmark("insert_mirrored", size, min_time_ms, [&](long long &ops)
+        {
+            CDT work = cdt;
+            MeshMirror work_mesh;
+            work_mesh.build(work, true);
+            long long n = min<long long>(size, 256);
+            auto start = Clock::now();
+            for (long long k = 0; k < n; ++k)
+            {
+                work_mesh.inserted(work, work.insert(insertions[next_insertion++ % insertions.size()]));
+            }
+            ops += n;
+            return (double)chrono::duration_cast<chrono::nanoseconds>(Clock::now() - start).count();
+        }));
+
+        if (obtuse_faces.empty())
+        {
+            cout << "No obtuse faces for n=" << size << ", skipping the strategy benchmarks." << endl;
+            continue;
+        }
+
+        for (int strategy = 0; strategy < StrategySelector::strategy_count; ++strategy)
+        {
+            results.push_back(run_benchmark("select_steiner_point_" + to_string(strategy), size, min_time_ms, repeat(16, [&](long long i)
+            {
+                Face_handle face = obtuse_faces[i % obtuse_faces.size()];
+                Point a = face->vertex(0)->point();
+                Point b = face->vertex(1)->point();
+                Point c = face->vertex(2)->point();
+                Point steiner = select_steiner_point(a, b, c, strategy, cdt, region_boundary);
+                sink += (long long)steiner.x();
+            })));
+        }
+
+        results.push_back(run_benchmark("find_convex_polygon_around_obtuse_triangle", size, min_time_ms, repeat(16, [&](long long i)
+        {
+            Polygon_2 polygon = find_convex_polygon_around_obtuse_triangle(cdt, obtuse_faces[i % obtuse_faces.size()]);
+            sink += polygon.size();
+        })));
+    }
+
+    json j;
+    j["benchmarks"] = json::array();
+    for (const BenchResult &result : results)
+    {
+        j["benchmarks"].push_back({{"name", result.name}, {"size", result.size}, {"iterations", result.iterations}, {"ns_per_op", result.ns_per_op}});
+    }
+    ofstream file(output);
+    if (!file.is_open())
+    {
+        cerr << "Error: Could not open the file " << output << endl;
+        return 1;
+    }
+    file << j.dump(4) << endl;
+    cout << "Results written to " << output << endl;
+    return 0;
+}
@@ -0,0 +1,193 @@
+#include "triangulation_internal.h"
+#include "json.hpp"
+#include <sstream>
+#include <cstdio>
+#include <algorithm>
+#include <stdexcept>
+
+using json = nlohmann::json;
+
+// Checkpoints μεγάλων αναζητήσεων: η κατάσταση του engine γράφεται περιοδικά σε JSON, ώστε το --resume να συνεχίζει
+// από εκεί μετά από διακοπή. Οι καταστάσεις αποθηκεύονται ως λίστες αλλαγών στη μορφή του operation log.
+
+/////////////////////////////////////////////////////////
+
+static json operations_to_json(const vector<Operation> &operations)
+{
+    json list = json::array();
+    for (const Operation &operation : operations)
+    {
+        list.push_back(format_operation(operation));
+    }
+    return list;
+}
+
+static vector<Operation> operations_from_json(const json &list)
+{
+    vector<Operation> operations;
+    for (const json &line : list)
+    {
+        Operation operation;
+        if (!line.is_string() || !parse_operation(line.get<string>(), operation))
+            throw invalid_argument("Invalid operation in the checkpoint: " + line.dump());
+        operations.push_back(operation);
+    }
+    return operations;
+}
+
+// Εγγραφή σε προσωρινό αρχείο και μετονομασία, ώστε μια διακοπή κατά την εγγραφή να μην αφήνει μισό checkpoint
+bool write_checkpoint(const string &filename, const Checkpoint &checkpoint)
+{
+    json j;
+    j["engine"] = checkpoint.engine;
+    j["instance"] = checkpoint.instance;
+    j["setup"] = operations_to_json(checkpoint.setup);
+    j["best"] = operations_to_json(checkpoint.best);
+    j["frontier"] = json::array();
+    for (const vector<Operation> &state : checkpoint.frontier)
+    {
+        j["frontier"].push_back(operations_to_json(state));
+    }
+    j["rng_state"] = checkpoint.rng_state;
+    j["iteration"] = checkpoint.iteration;
+    j["temperature"] = checkpoint.temperature;
+    j["stalled_levels"] = checkpoint.stalled_levels;
+    j["selector_attempts"] = checkpoint.selector_attempts;
+    j["selector_successes"] = checkpoint.selector_successes;
+
+    string tmp_filename = filename + ".tmp";
+    ofstream file(tmp_filename);
+    if (!file.is_open())
+        return false;
+    file << j.dump();
+    file.close();
+    return file && rename(tmp_filename.c_str(), filename.c_str()) == 0;
+}
+
+Checkpoint read_checkpoint(const string &filename)
+{
+    ifstream file(filename);
+    if (!file.is_open())
+        throw invalid_argument("Could not open the checkpoint '" + filename + "'.");
+    try
+    {
+        json j;
+        file >> j;
+        Checkpoint checkpoint;
+        checkpoint.engine = j.at("engine").get<string>();
+        checkpoint.instance = j.at("instance").get<string>();
+        checkpoint.setup = operations_from_json(j.at("setup"));
+        checkpoint.best = operations_from_json(j.at("best"));
+        for (const json &state : j.at("frontier"))
+        {
+            checkpoint.frontier.push_back(operations_from_json(state));
+        }
+        checkpoint.rng_state = j.at("rng_state").get<string>();
+        checkpoint.iteration = j.at("iteration").get<int>();
+        checkpoint.temperature = j.at("temperature").get<double>();
+        checkpoint.stalled_levels = j.at("stalled_levels").get<int>();
+        checkpoint.selector_attempts = j.at("selector_attempts").get<vector<int>>();
+        checkpoint.selector_successes = j.at("selector_successes").get<vector<int>>();
+        return checkpoint;
+    }
+    catch (const json::exception &error)
+    {
+        throw invalid_argument("Invalid checkpoint '" + filename + "': " + error.what());
+    }
+}
+
+// Αναγνωριστικό ενός instance: το πλήθος των σημείων και ένα hash (FNV-1a) των συντεταγμένων, του ορίου και των
+// constraints. Ένα checkpoint συνεχίζεται μόνο στο instance στο οποίο γράφτηκε.
+string instance_fingerprint(const Instance &instance)
+{
+    uint64_t hash_val = 14695981039346656037ull;
+    auto mix = [&](long long value)
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            hash_val = (hash_val ^ ((uint64_t)value >> (8 * i) & 0xff)) * 1099511628211ull;
+        }
+    };
+    for (size_t i = 0; i < instance.point_count; ++i)
+    {
+        mix(instance.points_x[i]);
+        mix(instance.points_y[i]);
+    }
+    mix(instance.boundary_size);
+    for (size_t i = 0; i < instance.boundary_size; ++i)
+    {
+        mix(instance.region_boundary[i]);
+    }
+    mix(instance.constraint_count);
+    for (size_t i = 0; i < instance.constraint_count; ++i)
+    {
+        mix(instance.constraints[i].first);
+        mix(instance.constraints[i].second);
+    }
+    char hex[17];
+    snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)hash_val);
+    return to_string(instance.point_count) + ":" + hex;
+}
+
+// Η κατάσταση που προκύπτει από την αρχική με τις αλλαγές operations. Μια αλλαγή που δεν εφαρμόζεται σημαίνει ότι
+// το checkpoint δεν αντιστοιχεί σε αυτή την τριγωνοποίηση, οπότε δεν συνεχίζουμε από λάθος κατάσταση.
+State rebuild_state(const State &initial_state, const vector<Operation> &operations)
+{
+    State state = initial_state;
+    for (const Operation &operation : operations)
+    {
+        if (!apply_operation(state.cdt, operation))
+            throw invalid_argument("The checkpoint operation '" + format_operation(operation) + "' could not be applied.");
+        state.operations.push_back(operation);
+        if (operation.type == Operation::INSERT)
+        {
+            state.steiner_points++;
+            state.steiner_locations.push_back(operation.p);
+            state.strategies.push_back(operation.strategy);
+        }
+    }
+    state.obtuse_count = count_Obtuse_Angles(state.cdt);
+    return state;
+}
+
+string save_rng(const mt19937 &rng)
+{
+    ostringstream stream;
+    stream << rng;
+    return stream.str();
+}
+
+void restore_rng(mt19937 &rng, const string &saved)
+{
+    if (saved.empty())
+        return;
+    istringstream stream(saved);
+    stream >> rng;
+}
+
+/////////////////////////////////////////////////////////
+
+Checkpointer::Checkpointer(const string &filename, long long interval_ms, const string &engine, const string &instance, const vector<Operation> &setup,
+                           ostream *log)
+    : filename(filename), interval_ms(interval_ms), engine(engine), instance(instance), setup(setup), log(log), last(chrono::steady_clock::now())
+{
+}
+
+bool Checkpointer::due() const
+{
+    return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - last).count() >= interval_ms;
+}
+
+// Συμπληρώνει τα κοινά πεδία (engine, instance, setup, στατιστικά του selector) και γράφει το checkpoint
+void Checkpointer::save(Checkpoint &checkpoint, StrategySelector &selector)
+{
+    checkpoint.engine = engine;
+    checkpoint.instance = instance;
+    checkpoint.setup = setup;
+    selector.save(checkpoint.selector_attempts, checkpoint.selector_successes);
+    if (write_checkpoint(filename, checkpoint))
+        progress_log(log) << "Checkpoint written to '" << filename << "'" << endl;
+    else
+        cerr << "Warning: could not write the checkpoint '" << filename << "'." << endl;
+    last = chrono::steady_clock::now();
+}
@@ -0,0 +1,282 @@
+#include "triangulation_internal.h"
+#include <algorithm>
+#include <cmath>
+#include <climits>
+#include <unordered_map>
+
+// Engines αναζήτησης εκτός του BFS (βλ. triangulation.cpp)
+
+/////////////////////////////////////////////////////////
+
+// Τοπική βελτίωση: σε κάθε βήμα προστίθεται το Steiner point που μειώνει περισσότερο τα αμβλυγώνια στο πρώτο τρίγωνο
+// όπου υπάρχει βελτίωση. Οι στρατηγικές δοκιμάζονται με τη σειρά του StrategySelector. Με rng τα τρίγωνα
+// δοκιμάζονται με τυχαία σειρά και κρατάμε την πρώτη βελτίωση.
+static State greedy_descent(State state, SearchContext &context, mt19937 *rng)
+{
+    bool improved = true;
+    ScratchCDT scratch; // δοκιμαστικές εισαγωγές αυτού του worker
+    MeshMirror mesh;    // ακολουθεί το state.cdt σε κάθε εισαγωγή
+    mesh.build(state.cdt, true);
+
+    while (improved && state.obtuse_count > 0 && state.steiner_points < context.options.max_depth && !context.stop.should_stop())
+    {
+        if (context.pruned(state.obtuse_count, state.steiner_points))
+            break;
+        improved = false;
+        STATS_COUNT(STAT_SEARCH_ITERATIONS);
+        // Στο greedy engine η κατάσταση είναι μόνο η τρέχουσα λύση (στο restarts γράφει checkpoints το ίδιο)
+        if (!rng && context.checkpoint_due())
+        {
+            Checkpoint checkpoint;
+            checkpoint.best = state.operations;
+            context.checkpoint(checkpoint);
+        }
+
+        vector<int32_t> faces = mesh.obtuse_faces();
+        context.trace_iteration(faces.size());
+        scratch.sync(state.cdt);
+        if (rng)
+            shuffle(faces.begin(), faces.end(), *rng);
+        // Ακριβή αποτελέσματα (πλήρης αξιολόγηση ή επαλήθευση) των σημείων αυτού του γύρου, ώστε τα ίδια σημεία από
+        // γειτονικά τρίγωνα να μην αξιολογούνται ξανά. Οι εκτιμήσεις (predict/submesh) εξαρτώνται από το τρίγωνο,
+        // οπότε δεν αποθηκεύονται.
+        unordered_map<SnappedPoint, int, SnappedPointHash> evaluated;
+
+        for (int32_t index : faces)
+        {
+            if (context.stop.should_stop())
+                break;
+            Face_handle face = mesh.handle(index);
+            Point a = mesh.point(index, 0);
+            Point b = mesh.point(index, 1);
+            Point c = mesh.point(index, 2);
+            int face_class = mesh.classify(index);
+
+            Point best_point;
+            int best_obtuse = state.obtuse_count;
+            int best_strategy = -1;
+            int evaluations = 0;
+            for (int strategy : context.selector.order(face_class))
+            {
+                if (evaluations >= context.options.strategy_cutoff)
+                    break;
+                Point steiner;
+                if (!propose_steiner_point(context, a, b, c, strategy, mesh, steiner))
+                {
+                    context.selector.update(face_class, strategy, false);
+                    continue;
+                }
+
+                // Ένα σημείο που έχει ήδη αξιολογηθεί δεν έδωσε βελτίωση (αλλιώς ο γύρος θα είχε τελειώσει). Η
+                // αξιολόγησή του έχει ήδη μετρηθεί στον selector και στα στατιστικά, οπότε δεν μετράει ξανά.
+                SnappedPoint key = snap_point(steiner);
+                auto memo = evaluated.find(key);
+                int new_obtuse;
+                evaluations++;
+                if (memo != evaluated.end())
+                {
+                    new_obtuse = memo->second;
+                }
+                else
+                {
+                    new_obtuse = evaluate_candidate(context, state.cdt, scratch, state.obtuse_count, face, steiner);
+                    if (context.evaluation == FULL_EVALUATION)
+                        evaluated[key] = new_obtuse;
+                    context.selector.update(face_class, strategy, new_obtuse < state.obtuse_count);
+                    if (new_obtuse != INT_MAX)
+                        context.strategy_stats.evaluated(strategy, new_obtuse - state.obtuse_count);
+                }
+                if (new_obtuse < best_obtuse)
+                {
+                    best_point = steiner;
+                    best_obtuse = new_obtuse;
+                    best_strategy = strategy;
+                    if (rng)
+                        break;
+                }
+            }
+
+            // Με εκτίμηση επαληθεύουμε με πραγματική εισαγωγή μόνο το σημείο που επιλέχθηκε
+            if (best_strategy >= 0 && context.evaluation != FULL_EVALUATION)
+            {
+                best_obtuse = verify_candidate(scratch, state.obtuse_count, face, best_point);
+                evaluated[snap_point(best_point)] = best_obtuse;
+                if (best_obtuse >= state.obtuse_count)
+                    best_strategy = -1;
+            }
+
+            // Εφαρμογή της καλύτερης στρατηγικής (απευθείας στο cdt της κατάστασης) και νέος γύρος από την αρχή
+            if (best_strategy >= 0)
+            {
+                state.operations.push_back(insert_operation(best_point, best_strategy, face));
+                mesh.inserted(state.cdt, state.cdt.insert(best_point));
+                STATS_COUNT(STAT_INSERTIONS);
+                state.obtuse_count = best_obtuse;
+                state.steiner_points++;
+                state.steiner_locations.push_back(best_point);
+                state.strategies.push_back(best_strategy);
+                context.strategy_stats.accepted(best_strategy);
+                context.report(state);
+                improved = true;
+                break;
+            }
+        }
+    }
+    return state;
+}
+
+State greedy_triangulation(const State &initial_state, SearchContext &context, mt19937 &)
+{
+    if (context.resume)
+        return greedy_descent(rebuild_state(initial_state, context.resume->best), context, nullptr);
+    return greedy_descent(initial_state, context, nullptr);
+}
+
+// Τυχαιοποιημένη τοπική βελτίωση με επανεκκινήσεις από την αρχική κατάσταση
+State restarts_triangulation(const State &initial_state, SearchContext &context, mt19937 &rng)
+{
+    State best_state = initial_state;
+    int first_restart = 0;
+    if (context.resume)
+    {
+        best_state = rebuild_state(initial_state, context.resume->best);
+        first_restart = context.resume->iteration;
+        restore_rng(rng, context.resume->rng_state);
+    }
+    for (int restart = first_restart; restart < context.options.restarts && !context.stop.should_stop(); ++restart)
+    {
+        State result = greedy_descent(initial_state, context, &rng);
+        if (is_better_state(result, best_state))
+            best_state = result;
+        if (context.checkpoint_due())
+        {
+            Checkpoint checkpoint;
+            checkpoint.best = best_state.operations;
+            checkpoint.iteration = restart + 1;
+            checkpoint.rng_state = save_rng(rng);
+            context.checkpoint(checkpoint);
+        }
+    }
+    return best_state;
+}
+
+// Simulated annealing: σε κάθε βήμα προστίθεται ένα Steiner point σε τυχαίο αμβλυγώνιο τρίγωνο
+// και η νέα κατάσταση γίνεται δεκτή με πιθανότητα exp(-ΔE/T), όπου E = alpha * αμβλυγώνια + beta * Steiner points
+State annealing_triangulation(const State &initial_state, SearchContext &context, mt19937 &rng)
+{
+    const double alpha = 2.0;
+    const double beta = 0.2;
+    const double cooling = 0.95;
+    const int steps_per_temperature = 50;
+    auto energy = [&](const State &state)
+    {
+        return alpha * state.obtuse_count + beta * state.steiner_points;
+    };
+
+    uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    State current = initial_state;
+    State best_state = initial_state;
+    double temperature = 1.0;
+    int stalled_levels = 0; // θερμοκρασίες στη σειρά χωρίς βελτίωση της καλύτερης λύσης
+    if (context.resume && !context.resume->frontier.empty())
+    {
+        current = rebuild_state(initial_state, context.resume->frontier[0]);
+        best_state = rebuild_state(initial_state, context.resume->best);
+        temperature = context.resume->temperature;
+        stalled_levels = context.resume->stalled_levels;
+        restore_rng(rng, context.resume->rng_state);
+    }
+    // Δοκιμαστικές εισαγωγές, συγχρονισμένες με το current (ξανά σε κάθε αλλαγή του), και το mirror του current
+    ScratchCDT scratch;
+    scratch.sync(current.cdt);
+    MeshMirror mesh;
+    mesh.build(current.cdt, true);
+
+    while (temperature > 1e-3 && stalled_levels < context.options.max_iterations && best_state.obtuse_count > 0 && !context.stop.should_stop())
+    {
+        // Τα checkpoints γράφονται στην αρχή μιας θερμοκρασίας
+        if (context.checkpoint_due())
+        {
+            Checkpoint checkpoint;
+            checkpoint.best = best_state.operations;
+            checkpoint.frontier.push_back(current.operations);
+            checkpoint.temperature = temperature;
+            checkpoint.stalled_levels = stalled_levels;
+            checkpoint.rng_state = save_rng(rng);
+            context.checkpoint(checkpoint);
+        }
+        bool improved = false;
+        for (int step = 0; step < steps_per_temperature && !context.stop.should_stop(); ++step)
+        {
+            STATS_COUNT(STAT_SEARCH_ITERATIONS);
+            // Από κατάσταση που δεν μπορεί να προχωρήσει συνεχίζουμε από την καλύτερη
+            if (current.steiner_points >= context.options.max_depth || context.pruned(current.obtuse_count, current.steiner_points))
+            {
+                if (best_state.steiner_points >= context.options.max_depth || context.pruned(best_state.obtuse_count, best_state.steiner_points))
+                    return best_state;
+                current = best_state;
+                scratch.sync(current.cdt);
+                mesh.build(current.cdt, true);
+            }
+
+            vector<int32_t> faces = mesh.obtuse_faces();
+            context.trace_iteration(faces.size());
+            if (faces.empty())
+                break;
+            int32_t index = faces[uniform_int_distribution<size_t>(0, faces.size() - 1)(rng)];
+            Face_handle face = mesh.handle(index);
+            Point a = mesh.point(index, 0);
+            Point b = mesh.point(index, 1);
+            Point c = mesh.point(index, 2);
+            // Η πιο υποσχόμενη στρατηγική κατά UCB1 (το UCB1 φροντίζει και για την εξερεύνηση των υπολοίπων)
+            int face_class = mesh.classify(index);
+            int strategy = context.selector.order(face_class)[0];
+            Point steiner;
+            if (!propose_steiner_point(context, a, b, c, strategy, mesh, steiner))
+            {
+                context.selector.update(face_class, strategy, false);
+                continue;
+            }
+
+            // Η απόφαση αποδοχής παίρνεται με την αξιολόγηση (ίσως εκτίμηση), ώστε οι απορρίψεις να μην κοστίζουν αντίγραφο.
+            // Αν γίνει δεκτή, το σημείο εισάγεται απευθείας στο cdt του current.
+            State next = {CDT(), 0, current.steiner_points + 1, current.steiner_locations, current.strategies, current.operations};
+            next.obtuse_count = evaluate_candidate(context, current.cdt, scratch, current.obtuse_count, face, steiner);
+            if (next.obtuse_count == INT_MAX)
+            {
+                context.selector.update(face_class, strategy, false);
+                continue;
+            }
+            context.selector.update(face_class, strategy, next.obtuse_count < current.obtuse_count);
+            context.strategy_stats.evaluated(strategy, next.obtuse_count - current.obtuse_count);
+            next.steiner_locations.push_back(steiner);
+            next.strategies.push_back(strategy);
+            next.operations.push_back(insert_operation(steiner, strategy, face));
+
+            double delta = energy(next) - energy(current);
+            if (delta < 0 || uniform(rng) < exp(-delta / temperature))
+            {
+                context.strategy_stats.accepted(strategy);
+                mesh.inserted(current.cdt, current.cdt.insert(steiner));
+                STATS_COUNT(STAT_INSERTIONS);
+                // Με εκτίμηση το ακριβές πλήθος δίνεται από το mirror μετά την εισαγωγή
+                current.obtuse_count = mesh.obtuse_count();
+                current.steiner_points = next.steiner_points;
+                current.steiner_locations.swap(next.steiner_locations);
+                current.strategies.swap(next.strategies);
+                current.operations.swap(next.operations);
+                scratch.sync(current.cdt);
+                if (is_better_state(current, best_state))
+                {
+                    best_state = current;
+                    context.report(best_state);
+                    improved = true;
+                }
+            }
+        }
+        stalled_levels = improved ? 0 : stalled_levels + 1;
+        temperature *= cooling;
+    }
+    return best_state;
+}
@@ -0,0 +1,418 @@
+#include "triangulation_internal.h"
+#include <algorithm>
+#include <thread>
+#include <climits>
+#include <set>
+#include <cmath>
+#include <stdexcept>
+
+// Αξιολόγηση υποψήφιων Steiner points
+
+/////////////////////////////////////////////////////////
+
+EvaluationMode parse_evaluation_mode(const string &name)
+{
+    if (name == "full")
+        return FULL_EVALUATION;
+    if (name == "predict")
+        return PREDICTED_EVALUATION;
+    if (name == "submesh")
+        return SUBMESH_EVALUATION;
+    throw invalid_argument("Unknown evaluation mode '" + name + "'.");
+}
+
+// Η μεταβολή των αμβλυγώνιων στη ζώνη σύγκρουσης του p που ξεκινά από το start: τα τρίγωνα της ζώνης
+// αντικαθίστανται από τη βεντάλια του p προς το όριό της. Παραλείπονται τα άπειρα τρίγωνα και η ακμή split, πάνω
+// στην οποία βρίσκεται το p (η βεντάλια θα είχε εκεί ένα εκφυλισμένο τρίγωνο).
+static int conflict_zone_delta(const CDT &cdt, const Point &p, Face_handle start, Vertex_handle split_a, Vertex_handle split_b)
+{
+    vector<Face_handle> zone;
+    vector<CDT::Edge> boundary;
+    cdt.get_conflicts_and_boundary(p, back_inserter(zone), back_inserter(boundary), start);
+
+    int removed = 0;
+    for (Face_handle f : zone)
+    {
+        if (cdt.is_infinite(f))
+            continue;
+        Point a = f->vertex(0)->point();
+        Point b = f->vertex(1)->point();
+        Point c = f->vertex(2)->point();
+        removed += is_obtuse_triangle(a, b, c);
+    }
+    int added = 0;
+    Point q = p;
+    for (const CDT::Edge &edge : boundary)
+    {
+        Vertex_handle u = edge.first->vertex(cdt.cw(edge.second));
+        Vertex_handle w = edge.first->vertex(cdt.ccw(edge.second));
+        if (cdt.is_infinite(u) || cdt.is_infinite(w))
+            continue;
+        if ((u == split_a && w == split_b) || (u == split_b && w == split_a))
+            continue;
+        Point a = u->point();
+        Point b = w->point();
+        added += is_obtuse_triangle(q, a, b);
+    }
+    return added - removed;
+}
+
+// Πρόβλεψη της μεταβολής των αμβλυγώνιων από την εισαγωγή του p χωρίς να αλλάξει η τριγωνοποίηση, από τη ζώνη
+// σύγκρουσης (get_conflicts_and_boundary). Ένα σημείο πάνω σε ακμή με constraint τη χωρίζει στα δύο και η ζώνη
+// σταματά στην ακμή, οπότε προβλέπεται χωριστά κάθε πλευρά της. Η πρόβλεψη επαληθεύεται με πραγματική εισαγωγή
+// μόνο για το σημείο που επιλέγεται.
+bool predict_insertion_delta(const CDT &cdt, const Point &p, int &delta)
+{
+    if (cdt.dimension() < 2)
+        return false;
+    CDT::Locate_type lt;
+    int li;
+    Face_handle located = cdt.locate(p, lt, li);
+    if (lt != CDT::FACE && lt != CDT::EDGE)
+        return false;
+
+    if (lt == CDT::EDGE && cdt.is_constrained(CDT::Edge(located, li)))
+    {
+        Vertex_handle a = located->vertex(cdt.cw(li));
+        Vertex_handle b = located->vertex(cdt.ccw(li));
+        delta = 0;
+        for (Face_handle side : {located, located->neighbor(li)})
+        {
+            if (!cdt.is_infinite(side))
+                delta += conflict_zone_delta(cdt, p, side, a, b);
+        }
+        return true;
+    }
+    delta = conflict_zone_delta(cdt, p, located, Vertex_handle(), Vertex_handle());
+    return true;
+}
+
+/////////////////////////////////////////////////////////
+
+// Βήμα του πλέγματος για την ταύτιση υποψήφιων σημείων (οι είσοδοι έχουν ακέραιες συντεταγμένες)
+static const double SNAP_SCALE = 1e6;
+
+SnappedPoint snap_point(const Point &p)
+{
+    return SnappedPoint(llround(CGAL::to_double(p.x()) * SNAP_SCALE), llround(CGAL::to_double(p.y()) * SNAP_SCALE));
+}
+
+/////////////////////////////////////////////////////////
+
+static pair<Point, Point> make_point_pair(const Point &a, const Point &b)
+{
+    return a < b ? make_pair(a, b) : make_pair(b, a);
+}
+
+// Τα τρίγωνα του τοπικού CDT που ανήκουν στο submesh: ξεκινώντας από τα seeds διασχίζουμε όλες τις ακμές εκτός
+// από αυτές του ορίου (τα constraints του αρχικού CDT στο εσωτερικό του submesh διασχίζονται κανονικά)
+static set<Face_handle> submesh_faces(const CDT &local, const Submesh &submesh)
+{
+    set<Face_handle> inside;
+    vector<Face_handle> stack;
+    for (const Point &seed : submesh.seeds)
+    {
+        Face_handle f = local.locate(seed);
+        if (!local.is_infinite(f) && inside.insert(f).second)
+            stack.push_back(f);
+    }
+    while (!stack.empty())
+    {
+        Face_handle f = stack.back();
+        stack.pop_back();
+        for (int i = 0; i < 3; ++i)
+        {
+            Face_handle n = f->neighbor(i);
+            if (local.is_infinite(n) || inside.count(n))
+                continue;
+            if (local.is_constrained(CDT::Edge(f, i)) &&
+                submesh.boundary.count(make_point_pair(f->vertex(local.cw(i))->point(), f->vertex(local.ccw(i))->point())))
+                continue;
+            inside.insert(n);
+            stack.push_back(n);
+        }
+    }
+    return inside;
+}
+
+static int count_obtuse(const set<Face_handle> &faces)
+{
+    int count = 0;
+    for (Face_handle f : faces)
+    {
+        Point a = f->vertex(0)->point();
+        Point b = f->vertex(1)->point();
+        Point c = f->vertex(2)->point();
+        count += is_obtuse_triangle(a, b, c);
+    }
+    return count;
+}
+
+// Εξαγωγή των τριγώνων σε απόσταση έως rings (μέσω ακμών) από το face σε ένα μικρό ανεξάρτητο CDT.
+// Οι ακμές του ορίου μπαίνουν ως constraints, οπότε μια εισαγωγή στο εσωτερικό δεν μπορεί να αλλάξει τίποτα έξω
+// από το submesh και το κόστος μιας δοκιμής δεν εξαρτάται από το μέγεθος της τριγωνοποίησης.
+Submesh extract_submesh(const CDT &cdt, Face_handle face, int rings)
+{
+    set<Face_handle> ring_faces = {face};
+    vector<Face_handle> frontier = {face};
+    for (int r = 0; r < rings; ++r)
+    {
+        vector<Face_handle> next;
+        for (Face_handle f : frontier)
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                Face_handle n = f->neighbor(i);
+                if (!cdt.is_infinite(n) && ring_faces.insert(n).second)
+                    next.push_back(n);
+            }
+        }
+        frontier.swap(next);
+    }
+
+    Submesh submesh;
+    set<Point> vertices;
+    vector<pair<Point, Point>> constraints;
+    for (Face_handle f : ring_faces)
+    {
+        submesh.seeds.push_back(CGAL::centroid(f->vertex(0)->point(), f->vertex(1)->point(), f->vertex(2)->point()));
+        for (int i = 0; i < 3; ++i)
+        {
+            vertices.insert(f->vertex(i)->point());
+            Face_handle n = f->neighbor(i);
+            pair<Point, Point> edge = make_point_pair(f->vertex(cdt.cw(i))->point(), f->vertex(cdt.ccw(i))->point());
+            if (cdt.is_infinite(n) || !ring_faces.count(n))
+            {
+                submesh.boundary.insert(edge);
+                constraints.push_back(edge);
+            }
+            else if (cdt.is_constrained(CDT::Edge(f, i)) && f < n)
+            {
+                constraints.push_back(edge);
+            }
+        }
+    }
+    submesh.cdt.insert(vertices.begin(), vertices.end());
+    for (const auto &constraint : constraints)
+    {
+        submesh.cdt.insert_constraint(constraint.first, constraint.second);
+    }
+    submesh.inside = submesh_faces(submesh.cdt, submesh);
+    submesh.obtuse_count = count_obtuse(submesh.inside);
+    return submesh;
+}
+
+// Μεταβολή των αμβλυγώνιων από την εισαγωγή του p σε αντίγραφο του submesh. Επιστρέφει false αν το p δεν είναι
+// στο εσωτερικό του submesh (τότε η εισαγωγή θα άλλαζε και τρίγωνα έξω από αυτό).
+bool submesh_insertion_delta(const Submesh &submesh, const Point &p, int &delta)
+{
+    CDT::Locate_type lt;
+    int li;
+    Face_handle located = submesh.cdt.locate(p, lt, li);
+    if (lt != CDT::FACE && lt != CDT::EDGE)
+        return false;
+    if (!submesh.inside.count(located))
+        return false;
+    for (const auto &edge : submesh.boundary)
+    {
+        if (K::Segment_2(edge.first, edge.second).has_on(p))
+            return false;
+    }
+
+    CDT local = submesh.cdt;
+    local.insert(p);
+    delta = count_obtuse(submesh_faces(local, submesh)) - submesh.obtuse_count;
+    return true;
+}
+
+/////////////////////////////////////////////////////////
+
+// Εκτίμηση της μεταβολής των αμβλυγώνιων από την εισαγωγή του p (στο τρίγωνο face) χωρίς να αλλάξει το cdt
+bool estimate_insertion_delta(const SearchContext &context, const CDT &cdt, Face_handle face, const Point &p, int &delta)
+{
+    STATS_COUNT(STAT_CANDIDATE_EVALUATIONS);
+    if (context.evaluation == SUBMESH_EVALUATION)
+        return submesh_insertion_delta(extract_submesh(cdt, face, context.options.submesh_rings), p, delta);
+    return predict_insertion_delta(cdt, p, delta);
+}
+
+// Εκτιμήσεις για πολλά υποψήφια σημεία παράλληλα (μόνο ανάγνωση του cdt). INT_MAX για όσα δεν αξιολογούνται.
+vector<int> estimate_insertion_deltas(const SearchContext &context, const CDT &cdt, const vector<Face_handle> &faces, const vector<Point> &candidates)
+{
+    vector<int> deltas(candidates.size(), INT_MAX);
+    auto work = [&](size_t i)
+    {
+        int delta;
+        if (estimate_insertion_delta(context, cdt, faces[i], candidates[i], delta))
+            deltas[i] = delta;
+    };
+    // Για λίγα υποψήφια ο συγχρονισμός με τα νήματα κοστίζει περισσότερο από την αξιολόγηση
+    if (candidates.size() < 2 * context.workers.size())
+    {
+        for (size_t i = 0; i < candidates.size(); ++i)
+        {
+            work(i);
+        }
+        return deltas;
+    }
+    context.workers.parallel_for(candidates.size(), work);
+    return deltas;
+}
+
+// Αξιολόγηση ενός υποψήφιου σημείου: επιστρέφει τα αμβλυγώνια μετά την εισαγωγή (INT_MAX αν δεν αξιολογείται).
+// Στο FULL_EVALUATION το πλήθος είναι ακριβές (δοκιμαστική εισαγωγή στο scratch, συγχρονισμένο με το cdt),
+// στα υπόλοιπα είναι εκτίμηση.
+int evaluate_candidate(const SearchContext &context, const CDT &cdt, ScratchCDT &scratch, int obtuse_count, Face_handle face, const Point &p)
+{
+    if (context.evaluation != FULL_EVALUATION)
+    {
+        int delta;
+        return estimate_insertion_delta(context, cdt, face, p, delta) ? obtuse_count + delta : INT_MAX;
+    }
+    STATS_COUNT(STAT_CANDIDATE_EVALUATIONS);
+    return verify_candidate(scratch, obtuse_count, face, p);
+}
+
+// Ακριβής καταμέτρηση με δοκιμαστική εισαγωγή στο scratch
+int verify_candidate(ScratchCDT &scratch, int obtuse_count, Face_handle face, const Point &p)
+{
+    return scratch.insertion_obtuse(p, face, obtuse_count);
+}
+
+// Το cdt με το p εισαγμένο, για τη νέα κατάσταση όταν ένα σημείο γίνεται δεκτό
+void apply_candidate(const CDT &cdt, const Point &p, CDT &inserted)
+{
+    inserted = cdt;
+    inserted.insert(p);
+    STATS_COUNT(STAT_CDT_COPIES);
+    STATS_COUNT(STAT_INSERTIONS);
+}
+
+/////////////////////////////////////////////////////////
+
+void ScratchCDT::sync(const CDT &source)
+{
+    parent = &source;
+    stale = true;
+}
+
+// Τα αμβλυγώνια πεπερασμένα τρίγωνα γύρω από τις κορυφές vertices (κάθε τρίγωνο μία φορά)
+static int count_obtuse_around(const CDT &cdt, const vector<Vertex_handle> &vertices)
+{
+    set<Face_handle> faces;
+    for (Vertex_handle v : vertices)
+    {
+        CDT::Face_circulator fc = cdt.incident_faces(v), done = fc;
+        do
+        {
+            if (!cdt.is_infinite(fc))
+                faces.insert(fc);
+        } while (++fc != done);
+    }
+    int count = 0;
+    for (Face_handle f : faces)
+    {
+        Point a = f->vertex(0)->point();
+        Point b = f->vertex(1)->point();
+        Point c = f->vertex(2)->point();
+        count += is_obtuse_triangle(a, b, c);
+    }
+    return count;
+}
+
+// Οι πεπερασμένοι γείτονες της v, ταξινομημένοι, για σύγκριση κορυφών σε διαφορετικά CDT
+static vector<Point> neighbour_points(const CDT &cdt, Vertex_handle v)
+{
+    vector<Point> neighbours;
+    CDT::Vertex_circulator vc = cdt.incident_vertices(v), done = vc;
+    do
+    {
+        if (!cdt.is_infinite(vc))
+            neighbours.push_back(vc->point());
+    } while (++vc != done);
+    sort(neighbours.begin(), neighbours.end());
+    return neighbours;
+}
+
+int ScratchCDT::insertion_obtuse(const Point &p, Face_handle face, int parent_obtuse)
+{
+    bool fresh = stale;
+    if (stale)
+    {
+        // Με την arena (arena_allocator.h) τα μπλοκ του προηγούμενου αντιγράφου ξαναχρησιμοποιούνται
+        cdt = *parent;
+        hint = Face_handle();
+        stale = false;
+        STATS_COUNT(STAT_CDT_COPIES);
+    }
+    CDT::Locate_type lt;
+    int li;
+    Face_handle located = cdt.locate(p, lt, li, hint);
+    if (lt == CDT::VERTEX)
+        return parent_obtuse;
+    Vertex_handle v = cdt.insert(p, lt, located, li);
+    STATS_COUNT(STAT_INSERTIONS);
+
+    // Όλα τα τρίγωνα που άλλαξαν είναι στο star του v, οπότε τα τρίγωνα γύρω από το link πριν και μετά
+    // διαφέρουν μόνο σε αυτά. Το "πριν" μετριέται στο ίδιο το parent, γύρω από τις αντίστοιχες κορυφές του, ώστε
+    // η διαφορά να είναι ακριβής ό,τι κι αν αφήσει πίσω της η αφαίρεση. Αν κάποια κορυφή του link δεν υπάρχει στο
+    // parent, το scratch έχει αποκλίνει χωρίς να το πιάσει ο έλεγχος των γειτόνων: ξαναγίνεται αντίγραφο και η
+    // δοκιμή επαναλαμβάνεται.
+    vector<Vertex_handle> link, parent_link;
+    CDT::Vertex_circulator vc = cdt.incident_vertices(v), done = vc;
+    do
+    {
+        if (!cdt.is_infinite(vc))
+        {
+            CDT::Locate_type parent_lt;
+            int parent_li;
+            Face_handle f = parent->locate(vc->point(), parent_lt, parent_li, face);
+            if (parent_lt != CDT::VERTEX)
+            {
+                if (fresh)
+                    throw logic_error("The scratch CDT differs from a fresh copy of its parent.");
+                STATS_COUNT(STAT_SCRATCH_RESYNCS);
+                stale = true;
+                return insertion_obtuse(p, face, parent_obtuse);
+            }
+            link.push_back(vc);
+            parent_link.push_back(f->vertex(parent_li));
+        }
+    } while (++vc != done);
+    int before = count_obtuse_around(*parent, parent_link);
+    link.push_back(v);
+    int after = count_obtuse_around(cdt, link);
+    link.pop_back();
+
+    // Αφαίρεση του σημείου. Αν χώρισε μια ακμή με constraint, το constraint ξαναμπαίνει ολόκληρο.
+    vector<Vertex_handle> constrained;
+    if (cdt.are_there_incident_constraints(v))
+    {
+        CDT::Edge_circulator ec = cdt.incident_edges(v), edges_done = ec;
+        do
+        {
+            if (cdt.is_constrained(*ec))
+                constrained.push_back(ec->first->vertex(cdt.cw(ec->second)) == v ? ec->first->vertex(cdt.ccw(ec->second)) : ec->first->vertex(cdt.cw(ec->second)));
+        } while (++ec != edges_done);
+        cdt.remove_incident_constraints(v);
+    }
+    cdt.remove(v);
+    if (constrained.size() == 2)
+        cdt.insert_constraint(constrained[0], constrained[1]);
+
+    // Η επαναφορά είναι ακριβής αν οι κορυφές του link έχουν τους ίδιους γείτονες με το parent. Αλλιώς το
+    // αποτέλεσμα ισχύει, αλλά το scratch ξαναγίνεται αντίγραφο του parent στην επόμενη δοκιμή.
+    bool restored = constrained.empty() || constrained.size() == 2;
+    for (size_t i = 0; i < link.size() && restored; ++i)
+    {
+        restored = neighbour_points(*parent, parent_link[i]) == neighbour_points(cdt, link[i]);
+    }
+    if (!restored)
+    {
+        STATS_COUNT(STAT_SCRATCH_RESYNCS);
+        stale = true;
+    }
+    else
+        hint = link.empty() ? Face_handle() : link[0]->face();
+    return parent_obtuse + after - before;
+}
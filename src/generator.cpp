@@ -0,0 +1,206 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <set>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include "json.hpp"
+
+using json = nlohmann::json;
+using namespace std;
+
+// Γεννήτρια τυχαίων instances στη μορφή του CG:SHOP (το ίδιο schema που διαβάζει το loadDataFromJSON).
+// Το region_boundary είναι ένα τυχαίο αστεροειδές (γενικά μη κυρτό) πολύγωνο γύρω από το κέντρο, τα υπόλοιπα σημεία
+// είναι τυχαία στο εσωτερικό του και τα additional_constraints είναι τμήματα που δεν τέμνονται μεταξύ τους.
+//
+// Χρήση: instance_generator output.json --points n [--boundary m] [--constraints k] [--seed s] [--uid name]
+
+struct GeneratedPoint
+{
+    long long x, y;
+};
+
+static long long cross(const GeneratedPoint &o, const GeneratedPoint &a, const GeneratedPoint &b)
+{
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+// Αν τα τμήματα ab και cd τέμνονται (και στα άκρα τους)
+static bool segments_intersect(const GeneratedPoint &a, const GeneratedPoint &b, const GeneratedPoint &c, const GeneratedPoint &d)
+{
+    long long d1 = cross(c, d, a), d2 = cross(c, d, b), d3 = cross(a, b, c), d4 = cross(a, b, d);
+    if (((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) && ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0)))
+        return true;
+    auto on_segment = [](const GeneratedPoint &p, const GeneratedPoint &q, const GeneratedPoint &r)
+    {
+        return min(p.x, q.x) <= r.x && r.x <= max(p.x, q.x) && min(p.y, q.y) <= r.y && r.y <= max(p.y, q.y);
+    };
+    return (d1 == 0 && on_segment(c, d, a)) || (d2 == 0 && on_segment(c, d, b)) ||
+           (d3 == 0 && on_segment(a, b, c)) || (d4 == 0 && on_segment(a, b, d));
+}
+
+// Αστεροειδές πολύγωνο (CCW) γύρω από το center, με τις γωνίες των κορυφών ταξινομημένες ώστε ο έλεγχος
+// εσωτερικού σημείου να γίνεται με δυαδική αναζήτηση
+struct StarPolygon
+{
+    GeneratedPoint center;
+    vector<double> angles;
+    vector<GeneratedPoint> vertices;
+
+    bool contains(const GeneratedPoint &p) const
+    {
+        double angle = atan2((double)(p.y - center.y), (double)(p.x - center.x));
+        size_t i = upper_bound(angles.begin(), angles.end(), angle) - angles.begin();
+        const GeneratedPoint &a = vertices[(i + vertices.size() - 1) % vertices.size()];
+        const GeneratedPoint &b = vertices[i % vertices.size()];
+        return cross(a, b, p) > 0;
+    }
+};
+
+static StarPolygon make_star_polygon(long long radius, int vertex_count, mt19937 &rng)
+{
+    // Μία κορυφή σε κάθε ίσο τομέα: με τουλάχιστον 4 κορυφές κάθε κενό είναι μικρότερο από π,
+    // οπότε το πολύγωνο είναι αστεροειδές ως προς το κέντρο
+    uniform_real_distribution<double> jitter(0.1, 0.9);
+    uniform_real_distribution<double> scale(0.4, 1.0);
+    StarPolygon polygon;
+    polygon.center = {radius, radius};
+    for (int i = 0; i < vertex_count; ++i)
+    {
+        double a = -M_PI + (i + jitter(rng)) * 2 * M_PI / vertex_count;
+        double r = radius * scale(rng);
+        GeneratedPoint vertex = {polygon.center.x + llround(r * cos(a)), polygon.center.y + llround(r * sin(a))};
+        // Η στρογγύλευση μπορεί να αλλάξει τη γωνία, οπότε κρατάμε την πραγματική
+        polygon.angles.push_back(atan2((double)(vertex.y - polygon.center.y), (double)(vertex.x - polygon.center.x)));
+        polygon.vertices.push_back(vertex);
+    }
+    return polygon;
+}
+
+int main(int argc, char **argv)
+{
+    string output;
+    long long point_count = 100;
+    int boundary_count = -1;
+    long long constraint_count = -1;
+    unsigned seed = 0;
+    string uid;
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        if (arg == "--points" && i + 1 < argc)
+            point_count = atoll(argv[++i]);
+        else if (arg == "--boundary" && i + 1 < argc)
+            boundary_count = atoi(argv[++i]);
+        else if (arg == "--constraints" && i + 1 < argc)
+            constraint_count = atoll(argv[++i]);
+        else if (arg == "--seed" && i + 1 < argc)
+            seed = strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--uid" && i + 1 < argc)
+            uid = argv[++i];
+        else if (!arg.empty() && arg[0] != '-' && output.empty())
+            output = arg;
+        else
+        {
+            output.clear();
+            break;
+        }
+    }
+    if (output.empty() || point_count < 4)
+    {
+        cerr << "Usage: " << argv[0] << " output.json --points n [--boundary m] [--constraints k] [--seed s] [--uid name]" << endl;
+        return 1;
+    }
+
+    // Προεπιλογές που μεγαλώνουν ομαλά από 10 έως 1M σημεία
+    if (boundary_count < 0)
+        boundary_count = (int)min<long long>(256, 4 + (long long)sqrt((double)point_count) / 4);
+    boundary_count = (int)min<long long>(max(boundary_count, 4), point_count);
+    if (constraint_count < 0)
+        constraint_count = point_count / 50;
+    if (uid.empty())
+        uid = "random_" + to_string(point_count) + "_" + to_string(seed);
+
+    mt19937 rng(seed);
+    long long radius = max<long long>(1000, 10 * point_count);
+    StarPolygon region = make_star_polygon(radius, boundary_count, rng);
+
+    // Τα σημεία του ορίου είναι τα πρώτα, ακολουθούν τα εσωτερικά
+    vector<GeneratedPoint> points = region.vertices;
+    set<pair<long long, long long>> used;
+    for (const GeneratedPoint &p : points)
+    {
+        used.insert(make_pair(p.x, p.y));
+    }
+    uniform_int_distribution<long long> coordinate(0, 2 * radius);
+    while ((long long)points.size() < point_count)
+    {
+        GeneratedPoint p = {coordinate(rng), coordinate(rng)};
+        if (region.contains(p) && used.insert(make_pair(p.x, p.y)).second)
+            points.push_back(p);
+    }
+
+    // Constraints: το πολύ ένα τμήμα ανά κελί ενός πλέγματος, ώστε να μην τέμνονται μεταξύ τους, και μόνο όσα
+    // δεν τέμνουν το όριο
+    vector<pair<int, int>> constraints;
+    if (constraint_count > 0)
+    {
+        long long cells = max<long long>(1, (long long)ceil(sqrt((double)constraint_count)));
+        long long cell_size = (2 * radius) / cells + 1;
+        vector<vector<int>> buckets(cells * cells);
+        for (size_t i = boundary_count; i < points.size(); ++i)
+        {
+            buckets[(points[i].x / cell_size) * cells + points[i].y / cell_size].push_back((int)i);
+        }
+        for (const vector<int> &bucket : buckets)
+        {
+            if ((long long)constraints.size() >= constraint_count)
+                break;
+            if (bucket.size() < 2)
+                continue;
+            const GeneratedPoint &a = points[bucket[0]];
+            const GeneratedPoint &b = points[bucket[1]];
+            bool crosses = false;
+            for (int i = 0; i < boundary_count && !crosses; ++i)
+            {
+                crosses = segments_intersect(a, b, region.vertices[i], region.vertices[(i + 1) % boundary_count]);
+            }
+            if (!crosses)
+                constraints.push_back(make_pair(bucket[0], bucket[1]));
+        }
+    }
+
+    json j;
+    j["instance_uid"] = uid;
+    j["num_points"] = points.size();
+    vector<long long> points_x, points_y;
+    for (const GeneratedPoint &p : points)
+    {
+        points_x.push_back(p.x);
+        points_y.push_back(p.y);
+    }
+    j["points_x"] = points_x;
+    j["points_y"] = points_y;
+    vector<int> boundary;
+    for (int i = 0; i < boundary_count; ++i)
+    {
+        boundary.push_back(i);
+    }
+    j["region_boundary"] = boundary;
+    j["num_constraints"] = constraints.size();
+    j["additional_constraints"] = constraints;
+
+    ofstream file(output);
+    if (!file.is_open())
+    {
+        cerr << "Error: Could not open the file " << output << endl;
+        return 1;
+    }
+    file << j.dump() << endl;
+    cout << "Instance '" << uid << "' (" << points.size() << " points, " << boundary_count << " boundary vertices, "
+         << constraints.size() << " constraints) written to " << output << endl;
+    return 0;
+}
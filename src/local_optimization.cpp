@@ -0,0 +1,472 @@
+#include "triangulation_internal.h"
+#include <deque>
+#include <set>
+#include <thread>
+#include <cmath>
+#include <stdexcept>
+
+// Τοπικές βελτιώσεις της τριγωνοποίησης που δεν χρειάζονται αναζήτηση
+
+/////////////////////////////////////////////////////////
+
+typedef pair<Vertex_handle, Vertex_handle> Vertex_pair;
+
+// Μία ακμή αναπαρίσταται από τις κορυφές της (με σταθερή σειρά), γιατί τα faces αλλάζουν μετά από κάθε flip
+static Vertex_pair make_vertex_pair(Vertex_handle u, Vertex_handle v)
+{
+    return u < v ? Vertex_pair(u, v) : Vertex_pair(v, u);
+}
+
+static int is_obtuse_triangle(Vertex_handle u, Vertex_handle v, Vertex_handle w)
+{
+    Point a = u->point();
+    Point b = v->point();
+    Point c = w->point();
+    return is_obtuse_triangle(a, b, c);
+}
+
+// Flips ακμών χωρίς constraint όσο μειώνουν τα αμβλυγώνια τρίγωνα, μέχρι να μην υπάρχει άλλο τέτοιο flip.
+// Κάθε flip μειώνει αυστηρά τα αμβλυγώνια, οπότε η διαδικασία τερματίζει. Επιστρέφει το πλήθος των flips
+// (και τα προσθέτει στο log, αν δοθεί).
+int flip_optimization(CDT &cdt, vector<Operation> *log)
+{
+    deque<Vertex_pair> worklist;
+    set<Vertex_pair> queued;
+    auto enqueue = [&](Vertex_handle u, Vertex_handle v)
+    {
+        Vertex_pair edge = make_vertex_pair(u, v);
+        if (!cdt.is_infinite(u) && !cdt.is_infinite(v) && queued.insert(edge).second)
+            worklist.push_back(edge);
+    };
+    for (auto eit = cdt.finite_edges_begin(); eit != cdt.finite_edges_end(); ++eit)
+    {
+        if (!cdt.is_constrained(*eit))
+            enqueue(eit->first->vertex(cdt.cw(eit->second)), eit->first->vertex(cdt.ccw(eit->second)));
+    }
+
+    int flips = 0;
+    while (!worklist.empty())
+    {
+        Vertex_pair edge = worklist.front();
+        worklist.pop_front();
+        queued.erase(edge);
+
+        // Η ακμή μπορεί να έχει ήδη αντικατασταθεί από προηγούμενο flip
+        Face_handle f;
+        int i;
+        if (!cdt.is_edge(edge.first, edge.second, f, i))
+            continue;
+        Face_handle g = f->neighbor(i);
+        if (cdt.is_constrained(CDT::Edge(f, i)) || cdt.is_infinite(f) || cdt.is_infinite(g))
+            continue;
+
+        // Το τετράπλευρο p-q-s-r γύρω από την ακμή q-r, με s την απέναντι κορυφή στο γειτονικό τρίγωνο
+        Vertex_handle p = f->vertex(i);
+        Vertex_handle q = f->vertex(cdt.ccw(i));
+        Vertex_handle r = f->vertex(cdt.cw(i));
+        Vertex_handle s = cdt.mirror_vertex(f, i);
+
+        // Το flip επιτρέπεται μόνο αν το τετράπλευρο είναι αυστηρά κυρτό
+        CGAL::Orientation side_q = CGAL::orientation(p->point(), s->point(), q->point());
+        CGAL::Orientation side_r = CGAL::orientation(p->point(), s->point(), r->point());
+        if (side_q == CGAL::COLLINEAR || side_r == CGAL::COLLINEAR || side_q == side_r)
+            continue;
+
+        int before = is_obtuse_triangle(p, q, r) + is_obtuse_triangle(s, r, q);
+        int after = is_obtuse_triangle(p, q, s) + is_obtuse_triangle(p, s, r);
+        if (after >= before)
+            continue;
+
+        if (log)
+            log->push_back(flip_operation(q->point(), r->point()));
+        cdt.flip(f, i);
+        flips++;
+        // Οι εξωτερικές ακμές του τετραπλεύρου μπορεί τώρα να επιδέχονται flip
+        enqueue(p, q);
+        enqueue(q, s);
+        enqueue(s, r);
+        enqueue(r, p);
+    }
+    return flips;
+}
+
+/////////////////////////////////////////////////////////
+
+// Οι γειτονικές κορυφές της v με τη σειρά ccw (το όριο του star polygon της v)
+static vector<Vertex_handle> vertex_link(CDT &cdt, Vertex_handle v)
+{
+    vector<Vertex_handle> link;
+    auto vc = cdt.incident_vertices(v), done = vc;
+    do
+    {
+        link.push_back(vc);
+    } while (++vc != done);
+    return link;
+}
+
+// Σημειώνει (ή ξεσημειώνει) την ακμή u-w ως constraint και στα δύο τρίγωνά της, χωρίς να αλλάξει η τριγωνοποίηση
+static void set_edge_constraint(CDT &cdt, Vertex_handle u, Vertex_handle w, bool constrained)
+{
+    Face_handle f;
+    int i;
+    if (!cdt.is_edge(u, w, f, i))
+        return;
+    f->set_constraint(i, constrained);
+    f->neighbor(i)->set_constraint(cdt.mirror_index(f, i), constrained);
+}
+
+// Οι ακμές του link γίνονται προσωρινά constraints, ώστε οι αφαιρέσεις και εισαγωγές στο εσωτερικό του star polygon
+// να μην αλλάζουν τίποτα έξω από αυτό. Επιστρέφει όσες δεν ήταν ήδη constraints, για το release_link.
+static vector<Vertex_pair> constrain_link(CDT &cdt, const vector<Vertex_handle> &link)
+{
+    vector<Vertex_pair> added;
+    for (size_t i = 0; i < link.size(); ++i)
+    {
+        Vertex_handle u = link[i], w = link[(i + 1) % link.size()];
+        Face_handle f;
+        int k;
+        if (cdt.is_edge(u, w, f, k) && !cdt.is_constrained(CDT::Edge(f, k)))
+        {
+            set_edge_constraint(cdt, u, w, true);
+            added.push_back(Vertex_pair(u, w));
+        }
+    }
+    return added;
+}
+
+static void release_link(CDT &cdt, const vector<Vertex_pair> &added)
+{
+    for (const Vertex_pair &edge : added)
+    {
+        set_edge_constraint(cdt, edge.first, edge.second, false);
+    }
+}
+
+// Εισάγει το p στο κενό star polygon με σύνορο το link (ccw) και επαναφέρει ακριβώς τη βεντάλια (p, link[i],
+// link[i+1]). Το p πρέπει να είναι στο εσωτερικό του kernel του polygon. Χρησιμοποιείται για την ακριβή αναίρεση
+// μιας αφαίρεσης ή μετακίνησης, όπου η απλή εισαγωγή θα έφτιαχνε το Delaunay star και όχι αυτό που υπήρχε.
+static Vertex_handle insert_fan(CDT &cdt, const Point &p, const vector<Vertex_handle> &link)
+{
+    vector<Vertex_pair> added = constrain_link(cdt, link);
+    Vertex_handle w = cdt.insert(p, link[0]->face());
+    for (Vertex_handle u : link)
+    {
+        cdt.insert_constraint(w, u);
+    }
+    for (Vertex_handle u : link)
+    {
+        set_edge_constraint(cdt, w, u, false);
+    }
+    release_link(cdt, added);
+    return w;
+}
+
+// Μετακίνηση της v (χωρίς constraints, με πεπερασμένο star) στο q, που πρέπει να είναι στο kernel του star polygon
+// της: η v αφαιρείται και το q εισάγεται ξανά, οπότε το star ξανατριγωνοποιείται ως constrained Delaunay, ενώ με τις
+// ακμές του link προσωρινά constraints τίποτα έξω από το star δεν αλλάζει. Το ίδιο κάνει και το replay (MOVE).
+Vertex_handle relocate_vertex(CDT &cdt, Vertex_handle v, const Point &q)
+{
+    vector<Vertex_handle> link = vertex_link(cdt, v);
+    vector<Vertex_pair> added = constrain_link(cdt, link);
+    cdt.remove(v);
+    Vertex_handle w = cdt.insert(q, link[0]->face());
+    release_link(cdt, added);
+    return w;
+}
+
+// Αμβλυγώνια τρίγωνα που έχουν όλες τις κορυφές τους στο σύνολο vertices.
+// Πριν και μετά την αφαίρεση μιας κορυφής, με vertices τον δακτύλιό της (και την ίδια πριν),
+// η διαφορά είναι ακριβώς η μεταβολή των αμβλυγώνιων λόγω της αφαίρεσης.
+static int count_obtuse_spanned(CDT &cdt, const set<Vertex_handle> &vertices)
+{
+    set<Face_handle> faces;
+    for (Vertex_handle v : vertices)
+    {
+        auto fc = cdt.incident_faces(v), done = fc;
+        do
+        {
+            Face_handle f = fc;
+            if (!cdt.is_infinite(f) && vertices.count(f->vertex(0)) && vertices.count(f->vertex(1)) && vertices.count(f->vertex(2)))
+                faces.insert(f);
+        } while (++fc != done);
+    }
+    int count = 0;
+    for (Face_handle f : faces)
+    {
+        count += is_obtuse_triangle(f->vertex(0), f->vertex(1), f->vertex(2));
+    }
+    return count;
+}
+
+// Πρόβλεψη της μεταβολής των αμβλυγώνιων αν αφαιρεθεί η v, χωρίς να αλλάξει η τριγωνοποίηση:
+// το CDT::remove ξανατριγωνοποιεί την τρύπα ως constrained Delaunay του star polygon, οπότε
+// κάνουμε το ίδιο σε ένα μικρό ξεχωριστό CDT. Μόνο ανάγνωση, άρα μπορεί να τρέξει παράλληλα.
+static int predict_removal_delta(CDT &cdt, Vertex_handle v)
+{
+    int before = 0;
+    auto fc = cdt.incident_faces(v), done = fc;
+    do
+    {
+        before += is_obtuse_triangle(fc->vertex(0), fc->vertex(1), fc->vertex(2));
+    } while (++fc != done);
+
+    vector<Vertex_handle> link = vertex_link(cdt, v);
+    CDT hole;
+    Polygon_2 polygon;
+    for (size_t i = 0; i < link.size(); ++i)
+    {
+        polygon.push_back(link[i]->point());
+        hole.insert_constraint(link[i]->point(), link[(i + 1) % link.size()]->point());
+    }
+    int after = 0;
+    for (auto fit = hole.finite_faces_begin(); fit != hole.finite_faces_end(); ++fit)
+    {
+        Point a = fit->vertex(0)->point();
+        Point b = fit->vertex(1)->point();
+        Point c = fit->vertex(2)->point();
+        Point centroid = CGAL::centroid(a, b, c);
+        if (polygon.bounded_side(centroid) == CGAL::ON_BOUNDED_SIDE)
+            after += is_obtuse_triangle(a, b, c);
+    }
+    return after - before;
+}
+
+// Αφαίρεση των Steiner points που δεν χρειάζονται πλέον: κρατάμε μια αφαίρεση όταν δεν αυξάνει τα αμβλυγώνια.
+// Σε κάθε γύρο επιλέγονται κορυφές με ξένα μεταξύ τους star polygons, οπότε οι αφαιρέσεις τους είναι ανεξάρτητες
+// και αξιολογούνται παράλληλα. Επιστρέφει τα σημεία που αφαιρέθηκαν (οι αλλαγές στο cdt μπαίνουν και στο log).
+// Σταματά στο χρονικό όριο ή σε ακύρωση, με το cdt πάντα έγκυρο.
+vector<Point> steiner_removal(CDT &cdt, const InstancePoints &points, unsigned threads, const StopCondition &stop, vector<Operation> *log)
+{
+    if (threads == 0)
+        threads = max(thread::hardware_concurrency(), 1u);
+    set<Point> original(points.begin(), points.end());
+    set<Point> rejected; // απορρίφθηκαν και η γειτονιά τους δεν έχει αλλάξει από τότε
+    vector<Point> removed;
+
+    while (!stop.should_stop())
+    {
+        // Υποψήφιες: Steiner points χωρίς constraints και με πεπερασμένο star, με ξένες γειτονιές μεταξύ τους
+        vector<Vertex_handle> selected;
+        set<Vertex_handle> marked;
+        for (auto vit = cdt.finite_vertices_begin(); vit != cdt.finite_vertices_end(); ++vit)
+        {
+            Vertex_handle v = vit;
+            if (original.count(v->point()) || rejected.count(v->point()) || cdt.are_there_incident_constraints(v) || marked.count(v))
+                continue;
+            vector<Vertex_handle> link = vertex_link(cdt, v);
+            bool independent = true;
+            for (Vertex_handle u : link)
+            {
+                independent = independent && !cdt.is_infinite(u) && !marked.count(u);
+            }
+            if (!independent)
+                continue;
+            selected.push_back(v);
+            marked.insert(v);
+            marked.insert(link.begin(), link.end());
+        }
+        if (selected.empty())
+            break;
+
+        // Παράλληλη πρόβλεψη της μεταβολής για κάθε υποψήφια, με όχι περισσότερα νήματα από τις υποψήφιες
+        vector<int> delta(selected.size());
+        vector<thread> workers;
+        unsigned round_threads = min<size_t>(threads, selected.size());
+        for (unsigned t = 0; t < round_threads; ++t)
+        {
+            workers.emplace_back([&, t]()
+                                 {
+                for (size_t i = t; i < selected.size(); i += round_threads)
+                {
+                    delta[i] = predict_removal_delta(cdt, selected[i]);
+                } });
+        }
+        for (thread &worker : workers)
+        {
+            worker.join();
+        }
+
+        // Εφαρμογή των αφαιρέσεων με επαλήθευση στην πραγματική τριγωνοποίηση
+        for (size_t i = 0; i < selected.size() && !stop.should_stop(); ++i)
+        {
+            Vertex_handle v = selected[i];
+            Point p = v->point();
+            if (delta[i] > 0)
+            {
+                rejected.insert(p);
+                continue;
+            }
+            vector<Vertex_handle> link = vertex_link(cdt, v);
+            set<Vertex_handle> neighbourhood(link.begin(), link.end());
+            neighbourhood.insert(v);
+            int before = count_obtuse_spanned(cdt, neighbourhood);
+            cdt.remove(v);
+            neighbourhood.erase(v);
+            if (count_obtuse_spanned(cdt, neighbourhood) > before)
+            {
+                // Η πρόβλεψη διέφερε (π.χ. ομοκυκλικά σημεία), οπότε επαναφέρουμε ακριβώς το star που υπήρχε. Το cdt
+                // είναι ίδιο με πριν, άρα στο log δεν γράφεται τίποτα.
+                Vertex_handle w = insert_fan(cdt, p, link);
+                neighbourhood.insert(w);
+                if (count_obtuse_spanned(cdt, neighbourhood) != before)
+                    throw logic_error("Restoring the Steiner point changed the obtuse count.");
+                rejected.insert(p);
+                continue;
+            }
+            if (log)
+                log->push_back(remove_operation(p));
+            removed.push_back(p);
+            // Οι γείτονες απέκτησαν νέο star, οπότε αξίζει να ξαναδοκιμαστούν
+            for (Vertex_handle u : link)
+            {
+                rejected.erase(u->point());
+            }
+        }
+    }
+    return removed;
+}
+
+/////////////////////////////////////////////////////////
+
+// Ποιότητα της θέσης p για μια κορυφή με δακτύλιο link: πρώτα το πλήθος των αμβλυγώνιων τριγώνων της βεντάλιας
+// (p, link[i], link[i+1]) και μετά μια συνεχής ποινή, το άθροισμα των υπερβάσεων των 90 μοιρών (σε rad)
+struct RelocationScore
+{
+    int obtuse;
+    double penalty;
+
+    bool operator<(const RelocationScore &other) const
+    {
+        return obtuse < other.obtuse || (obtuse == other.obtuse && penalty < other.penalty - 1e-12);
+    }
+};
+
+static double angle_excess(const Point &apex, const Point &u, const Point &w)
+{
+    double ux = u.x() - apex.x(), uy = u.y() - apex.y();
+    double wx = w.x() - apex.x(), wy = w.y() - apex.y();
+    double cosine = (ux * wx + uy * wy) / sqrt((ux * ux + uy * uy) * (wx * wx + wy * wy));
+    return max(0.0, acos(max(-1.0, min(1.0, cosine))) - M_PI / 2);
+}
+
+// Επιστρέφει false αν το p δεν είναι στο εσωτερικό του kernel του star polygon (η βεντάλια δεν θα ήταν έγκυρη)
+static bool relocation_score(const vector<Vertex_handle> &link, Point p, RelocationScore &score)
+{
+    score.obtuse = 0;
+    score.penalty = 0;
+    for (size_t i = 0; i < link.size(); ++i)
+    {
+        Point a = link[i]->point();
+        Point b = link[(i + 1) % link.size()]->point();
+        if (CGAL::orientation(a, b, p) != CGAL::LEFT_TURN)
+            return false;
+        score.obtuse += is_obtuse_triangle(p, a, b);
+        score.penalty += angle_excess(p, a, b) + angle_excess(a, b, p) + angle_excess(b, p, a);
+    }
+    return true;
+}
+
+// Μετακίνηση των Steiner points μέσα στο star polygon τους ώστε να ελαχιστοποιηθούν οι αμβλείες γωνίες γύρω τους.
+// Η νέα θέση αναζητείται με pattern search μέσα στο kernel, με βαθμολογία της βεντάλιας από τη νέα θέση. Η μετακίνηση
+// γίνεται με το relocate_vertex, που ξανατριγωνοποιεί μόνο το star, και κρατιέται μόνο αν η πραγματική καταμέτρηση
+// στο star δεν αυξήθηκε. Αλλιώς το star επανέρχεται ακριβώς. Επιστρέφει τις μετακινήσεις (από, προς).
+// Σταματά στο χρονικό όριο ή σε ακύρωση (οι μετακινήσεις που έγιναν μένουν).
+vector<pair<Point, Point>> steiner_relocation(CDT &cdt, const InstancePoints &points, const StopCondition &stop)
+{
+    const int max_rounds = 10;
+    const int max_steps = 40;
+    set<Point> original(points.begin(), points.end());
+    vector<pair<Point, Point>> moves;
+
+    for (int round = 0; round < max_rounds && !stop.should_stop(); ++round)
+    {
+        bool moved = false;
+        // Οι μετακινήσεις αντικαθιστούν κορυφές, οπότε οι υποψήφιες συλλέγονται πριν. Οι υπόλοιπες κορυφές δεν
+        // αλλάζουν, άρα τα handles τους μένουν έγκυρα.
+        vector<Vertex_handle> candidates;
+        for (auto vit = cdt.finite_vertices_begin(); vit != cdt.finite_vertices_end(); ++vit)
+        {
+            if (!original.count(vit->point()) && !cdt.are_there_incident_constraints(vit))
+                candidates.push_back(vit);
+        }
+        for (size_t k = 0; k < candidates.size() && !stop.should_stop(); ++k)
+        {
+            Vertex_handle v = candidates[k];
+            vector<Vertex_handle> link = vertex_link(cdt, v);
+            bool finite = true;
+            double nearest = 0;
+            for (Vertex_handle u : link)
+            {
+                finite = finite && !cdt.is_infinite(u);
+                if (finite)
+                {
+                    double d = CGAL::squared_distance(v->point(), u->point());
+                    nearest = (nearest == 0 || d < nearest) ? d : nearest;
+                }
+            }
+            if (!finite)
+                continue;
+
+            Point current = v->point();
+            RelocationScore best_score;
+            relocation_score(link, current, best_score);
+            if (best_score.obtuse == 0 && best_score.penalty == 0)
+                continue;
+
+            // Αρχικά δοκιμάζουμε το κέντρο βάρους του δακτυλίου, μετά pattern search με μειούμενο βήμα
+            Point best = current;
+            double cx = 0, cy = 0;
+            for (Vertex_handle u : link)
+            {
+                cx += u->point().x() / link.size();
+                cy += u->point().y() / link.size();
+            }
+            RelocationScore score;
+            if (relocation_score(link, Point(cx, cy), score) && score < best_score)
+            {
+                best = Point(cx, cy);
+                best_score = score;
+            }
+            double step = 0.25 * sqrt(nearest);
+            const double min_step = step * 1e-3;
+            const double directions[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {M_SQRT1_2, M_SQRT1_2}, {-M_SQRT1_2, M_SQRT1_2}, {M_SQRT1_2, -M_SQRT1_2}, {-M_SQRT1_2, -M_SQRT1_2}};
+            for (int it = 0; it < max_steps && step > min_step; ++it)
+            {
+                bool improved = false;
+                for (const auto &d : directions)
+                {
+                    Point candidate(best.x() + step * d[0], best.y() + step * d[1]);
+                    if (relocation_score(link, candidate, score) && score < best_score)
+                    {
+                        best = candidate;
+                        best_score = score;
+                        improved = true;
+                    }
+                }
+                if (!improved)
+                    step *= 0.5;
+            }
+
+            if (best == current)
+                continue;
+            set<Vertex_handle> neighbourhood(link.begin(), link.end());
+            neighbourhood.insert(v);
+            int before = count_obtuse_spanned(cdt, neighbourhood);
+            neighbourhood.erase(v);
+            Vertex_handle w = relocate_vertex(cdt, v, best);
+            neighbourhood.insert(w);
+            if (count_obtuse_spanned(cdt, neighbourhood) > before)
+            {
+                // Το constrained Delaunay star διέφερε από τη βεντάλια που βαθμολογήθηκε
+                cdt.remove(w);
+                insert_fan(cdt, current, link);
+                continue;
+            }
+            moves.push_back({current, best});
+            moved = true;
+        }
+        if (!moved)
+            break;
+    }
+    return moves;
+}
@@ -2,21 +2,28 @@
 #include <string>
 #include <fstream>
 #include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <csignal>
+#include <atomic>
+#include <stdexcept>
+#include <cerrno>
 #include "json.hpp"
 #include "triangulation.h"
+#include "stats.h"
 
 using json = nlohmann::json;
 using namespace std;
 
 // Συνάρτηση για φόρτωση των δεδομένων από το JSON αρχείο
-void loadDataFromJSON(const string &filename, vector<int> &points_x, vector<int> &points_y, vector<int> &region_boundary, vector<pair<int, int>> &additional_constraints, string &instance_uid)
+bool loadDataFromJSON(const string &filename, vector<int> &points_x, vector<int> &points_y, vector<int> &region_boundary, vector<pair<int, int>> &additional_constraints, string &instance_uid)
 {
     // Άνοιγμα αρχείου JSON
     ifstream inputFile(filename);
     if (!inputFile.is_open())
     {
         cerr << "Error: Could not open the file " << filename << endl;
-        return;
+        return false;
     }
 
     // Φόρτωση JSON δεδομένων
@@ -31,25 +38,124 @@ void loadDataFromJSON(const string &filename, vector<int> &points_x, vector<int>
     cout << "Όνομα που διαβάστηκε: " << instance_uid << endl;
     // Ανάγνωση των constraints
     additional_constraints = j["additional_constraints"].get<vector<pair<int, int>>>();
+    return true;
+}
+
+// Ακέραιος με προαιρετικό πρόσημο, χωρίς υπερχείλιση του long long
+static bool parseInteger(const string &text, long long &value)
+{
+    if (text.empty())
+        return false;
+    char *end;
+    errno = 0;
+    value = strtoll(text.c_str(), &end, 10);
+    return *end == '\0' && errno == 0 && text.find_first_not_of("+-0123456789") == string::npos;
+}
+
+// Συντεταγμένη μιας λύσης ως αριθμός ή ως κλάσμα "a/b" (και τα δύο επιτρέπονται στη μορφή του CG:SHOP). Ο solver
+// δουλεύει με double, οπότε ένα κλάσμα γίνεται δεκτό μόνο αν αναπαρίσταται ακριβώς (ανάγωγος παρονομαστής δύναμη
+// του 2 και αριθμητής έως 2^53), ώστε το σημείο να είναι ακριβώς αυτό που ελέγχει το verify. Πετάει
+// invalid_argument για κείμενο που δεν είναι αριθμός ή για κλάσμα που δεν αναπαρίσταται.
+double parseCoordinate(const json &value)
+{
+    if (value.is_number())
+        return value.get<double>();
+    string text = value.get<string>();
+    size_t slash = text.find('/');
+    if (slash == string::npos)
+    {
+        char *end;
+        double coordinate = strtod(text.c_str(), &end);
+        if (text.empty() || *end != '\0')
+            throw invalid_argument("Invalid coordinate '" + text + "'.");
+        return coordinate;
+    }
+    long long numerator, denominator;
+    if (!parseInteger(text.substr(0, slash), numerator) || !parseInteger(text.substr(slash + 1), denominator) || denominator == 0)
+        throw invalid_argument("Invalid coordinate '" + text + "'.");
+    long long divisor = llabs(denominator);
+    for (long long rest = llabs(numerator); rest != 0;)
+    {
+        long long r = divisor % rest;
+        divisor = rest;
+        rest = r;
+    }
+    numerator /= divisor;
+    denominator /= divisor;
+    if (denominator < 0)
+    {
+        numerator = -numerator;
+        denominator = -denominator;
+    }
+    const long long exact_limit = 1LL << 53;
+    if ((denominator & (denominator - 1)) != 0 || numerator > exact_limit || numerator < -exact_limit)
+        throw invalid_argument("The coordinate '" + text + "' is not exactly representable as a double.");
+    return double(numerator) / double(denominator);
 }
-void exportCompletionMessage(string instance_uid)
+
+// Φόρτωση των Steiner points μιας προηγούμενης λύσης για warm start
+bool loadWarmStart(const string &filename, const string &instance_uid, vector<double> &steiner_x, vector<double> &steiner_y)
 {
+    ifstream inputFile(filename);
+    if (!inputFile.is_open())
+    {
+        cerr << "Error: Could not open the file " << filename << endl;
+        return false;
+    }
+    try
+    {
+        json j;
+        inputFile >> j;
+        if (j.value("instance_uid", instance_uid) != instance_uid)
+            cerr << "Warning: the warm start solution is for instance '" << j["instance_uid"].get<string>() << "'." << endl;
+        const json &xs = j.at("steiner_points_x");
+        const json &ys = j.at("steiner_points_y");
+        for (size_t i = 0; i < xs.size() && i < ys.size(); ++i)
+        {
+            steiner_x.push_back(parseCoordinate(xs[i]));
+            steiner_y.push_back(parseCoordinate(ys[i]));
+        }
+    }
+    catch (const json::exception &error)
+    {
+        cerr << "Error: Invalid solution file " << filename << ": " << error.what() << endl;
+        return false;
+    }
+    catch (const invalid_argument &error)
+    {
+        cerr << "Error: Invalid solution file " << filename << ": " << error.what() << endl;
+        return false;
+    }
+    cout << "Warm start από το '" << filename << "': " << steiner_x.size() << " Steiner points" << endl;
+    return true;
+}
+
+// Εγγραφή της λύσης στο αρχείο εξόδου. Γράφουμε πρώτα σε προσωρινό αρχείο και μετά το μετονομάζουμε,
+// ώστε το αρχείο εξόδου να περιέχει πάντα μία ολόκληρη λύση ακόμη κι αν η διεργασία τερματιστεί στη μέση
+void exportCompletionMessage(const string &instance_uid, const Solution &solution, const string &filename)
+{
+    STATS_TIMER(STAT_TIMER_EXPORT);
     // Δημιουργία ενός JSON αντικειμένου
-    cout << instance_uid << endl;
     json outputData;
     outputData["content_type"] = "CG_SHOP_2025_Solution";
     outputData["instance_uid"] = instance_uid;
-    outputData["steiner_points_x"] = "sssss";
-    outputData["steiner_points_y"] = "sssss";
-    outputData["edges:"] = "sssss";
+    outputData["steiner_points_x"] = solution.steiner_points_x;
+    outputData["steiner_points_y"] = solution.steiner_points_y;
+    outputData["edges"] = solution.edges;
 
     // Άνοιγμα αρχείου για εγγραφή JSON δεδομένων
-    ofstream file("output.json");
+    string tmp_filename = filename + ".tmp";
+    ofstream file(tmp_filename);
     if (file.is_open())
     {
-        file << outputData.dump(6); // Εγγραφή του JSON με 4 space indentation
+        file << outputData.dump(6); // Εγγραφή του JSON με 6 space indentation
         file.close();
-        cout << "Το μήνυμα 'complete' αποθηκεύτηκε στο 'output.json'." << endl;
+        if (!file || rename(tmp_filename.c_str(), filename.c_str()) != 0)
+        {
+            cerr << "Σφάλμα: Αδυναμία εγγραφής του αρχείου '" << filename << "'." << endl;
+            return;
+        }
+        cout << "Η λύση (" << solution.obtuse_count << " αμβλυγώνια, " << solution.steiner_points << " Steiner points) αποθηκεύτηκε στο '" << filename << "'." << endl;
     }
     else
     {
@@ -57,7 +163,79 @@ void exportCompletionMessage(string instance_uid)
     }
 }
 
-int main()
+// Εγγραφή των χρονομέτρων και των μετρητών (stats.h) σε ξεχωριστό αρχείο
+void exportMetrics(const string &instance_uid, const Solution &solution, const string &filename)
+{
+    json metrics;
+    metrics["instance_uid"] = instance_uid;
+    metrics["obtuse_count"] = solution.obtuse_count;
+    metrics["steiner_points"] = solution.steiner_points;
+    json stats;
+    stats["enabled"] = stats_enabled();
+    for (int i = 0; i < STAT_COUNTER_COUNT; ++i)
+    {
+        stats["counters"][stats_counter_name((StatsCounter)i)] = stats_counter_value((StatsCounter)i);
+    }
+    for (int i = 0; i < STAT_TIMER_COUNT; ++i)
+    {
+        stats["timers"][stats_timer_name((StatsTimer)i)] = {{"ms", stats_timer_ms((StatsTimer)i)}, {"calls", stats_timer_calls_value((StatsTimer)i)}};
+    }
+    metrics["stats"] = stats;
+
+    ofstream file(filename);
+    if (!file.is_open())
+    {
+        cerr << "Σφάλμα: Αδυναμία ανοίγματος του αρχείου '" << filename << "' για εγγραφή." << endl;
+        return;
+    }
+    file << metrics.dump(4) << endl;
+    if (!stats_enabled())
+        cerr << "Warning: built without TRIANGULATION_STATS, the metrics in '" << filename << "' are all zero." << endl;
+}
+
+// Προσθήκη των στατιστικών ανά στρατηγική στο τέλος ενός CSV, ώστε πολλές εκτελέσεις (batch) να συγκεντρώνονται
+// στο ίδιο αρχείο. Η επικεφαλίδα γράφεται μόνο όταν το αρχείο είναι καινούργιο.
+void exportStrategyStats(const string &instance_uid, const Solution &solution, const string &filename)
+{
+    bool empty = true;
+    {
+        ifstream existing(filename);
+        empty = !existing.is_open() || existing.peek() == ifstream::traits_type::eof();
+    }
+    ofstream file(filename, ios::app);
+    if (!file.is_open())
+    {
+        cerr << "Σφάλμα: Αδυναμία ανοίγματος του αρχείου '" << filename << "' για εγγραφή." << endl;
+        return;
+    }
+    if (empty)
+        file << "instance_uid,strategy,attempts,out_of_domain,evaluated,average_delta,accepted,time_ms" << endl;
+    for (const StrategyReport &report : solution.strategy_reports)
+    {
+        file << instance_uid << "," << report.strategy << "," << report.attempts << "," << report.out_of_domain << ","
+             << report.evaluated << "," << report.average_delta << "," << report.accepted << "," << report.time_ms << endl;
+    }
+}
+
+// Σήμα τερματισμού που λήφθηκε (0 αν δεν έχει ληφθεί κανένα) και η αντίστοιχη σημαία ακύρωσης της αναζήτησης
+static volatile sig_atomic_t received_signal = 0;
+static atomic<bool> cancel_requested(false);
+
+// Ο handler μόνο σημειώνει το αίτημα, η αναζήτηση το ελέγχει και επιστρέφει την καλύτερη λύση.
+// Ένα δεύτερο σήμα τερματίζει αμέσως τη διεργασία με την προεπιλεγμένη συμπεριφορά.
+void handleTerminationSignal(int signum)
+{
+    received_signal = signum;
+    cancel_requested.store(true);
+    signal(signum, SIG_DFL);
+}
+
+void printUsage(const char *program)
+{
+    cerr << "Usage: " << program << " [input.json] [output.json] [--time-limit ms] [--max-depth n] [--max-iterations n] [--engine bfs|greedy|annealing|restarts|portfolio] [--threads n] [--seed n] [--restarts n] [--strategy-cutoff n] [--evaluation full|predict|submesh] [--submesh-rings n] [--metrics metrics.json] [--strategy-stats stats.csv] [--trace trace.csv|trace.jsonl] [--trace-interval ms] [--operation-log log.txt] [--replay log.txt] [--checkpoint file.json] [--checkpoint-interval ms] [--resume file.json] [--warm-start solution.json] [--no-flip] [--no-relocate] [--no-remove] [--no-draw]" << endl;
+}
+
+int main(int argc, char *argv[])
 {
     // Δεδομένα που θα φορτωθούν από το JSON αρχείο
     string instance_uid;
@@ -66,12 +244,128 @@ int main()
     vector<int> region_boundary;
     vector<pair<int, int>> additional_constraints;
 
+    // Ανάγνωση των παραμέτρων της γραμμής εντολών
+    string input_file = "data.json";
+    string output_file = "output.json";
+    string metrics_file;
+    string strategy_stats_file;
+    string replay_log;
+    string warm_start_file;
+    // Η βιβλιοθήκη από προεπιλογή δεν σχεδιάζει και δεν γράφει μηνύματα. Το εκτελέσιμο τα ενεργοποιεί.
+    SolverOptions options;
+    options.draw = true;
+    options.log = &cout;
+    int positional = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        if (arg == "--time-limit" && i + 1 < argc)
+            options.time_limit_ms = atoll(argv[++i]);
+        else if (arg == "--max-depth" && i + 1 < argc)
+            options.max_depth = atoi(argv[++i]);
+        else if (arg == "--max-iterations" && i + 1 < argc)
+            options.max_iterations = atoi(argv[++i]);
+        else if (arg == "--engine" && i + 1 < argc)
+            options.engine = argv[++i];
+        else if (arg == "--threads" && i + 1 < argc)
+            options.threads = atoi(argv[++i]);
+        else if (arg == "--seed" && i + 1 < argc)
+            options.seed = strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--restarts" && i + 1 < argc)
+            options.restarts = atoi(argv[++i]);
+        else if (arg == "--strategy-cutoff" && i + 1 < argc)
+            options.strategy_cutoff = atoi(argv[++i]);
+        else if (arg == "--evaluation" && i + 1 < argc)
+            options.evaluation = argv[++i];
+        else if (arg == "--submesh-rings" && i + 1 < argc)
+            options.submesh_rings = atoi(argv[++i]);
+        else if (arg == "--metrics" && i + 1 < argc)
+            metrics_file = argv[++i];
+        else if (arg == "--strategy-stats" && i + 1 < argc)
+            strategy_stats_file = argv[++i];
+        else if (arg == "--trace" && i + 1 < argc)
+            options.trace_file = argv[++i];
+        else if (arg == "--trace-interval" && i + 1 < argc)
+            options.trace_interval_ms = atoll(argv[++i]);
+        else if (arg == "--operation-log" && i + 1 < argc)
+            options.operation_log = argv[++i];
+        else if (arg == "--replay" && i + 1 < argc)
+            replay_log = argv[++i];
+        else if (arg == "--checkpoint" && i + 1 < argc)
+            options.checkpoint_file = argv[++i];
+        else if (arg == "--checkpoint-interval" && i + 1 < argc)
+            options.checkpoint_interval_ms = atoll(argv[++i]);
+        else if (arg == "--resume" && i + 1 < argc)
+            options.resume_file = argv[++i];
+        else if (arg == "--warm-start" && i + 1 < argc)
+            warm_start_file = argv[++i];
+        else if (arg == "--no-flip")
+            options.flip_edges = false;
+        else if (arg == "--no-relocate")
+            options.relocate_steiner = false;
+        else if (arg == "--no-remove")
+            options.remove_steiner = false;
+        else if (arg == "--no-draw")
+            options.draw = false;
+        else if (arg[0] != '-' && positional < 2)
+        {
+            if (positional++ == 0)
+                input_file = arg;
+            else
+                output_file = arg;
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
     // Κάλεσμα της συνάρτησης για φόρτωση δεδομένων
-    loadDataFromJSON("data.json", points_x, points_y, region_boundary, additional_constraints, instance_uid);
+    {
+        STATS_TIMER(STAT_TIMER_JSON_PARSE);
+        if (!loadDataFromJSON(input_file, points_x, points_y, region_boundary, additional_constraints, instance_uid))
+            return 1;
+        if (!warm_start_file.empty() && !loadWarmStart(warm_start_file, instance_uid, options.warm_start_x, options.warm_start_y))
+            return 1;
+    }
+
+    // Σε SIGINT/SIGTERM η αναζήτηση σταματά και γράφεται η καλύτερη λύση πριν τον τερματισμό
+    options.cancel_flag = &cancel_requested;
+    signal(SIGINT, handleTerminationSignal);
+    signal(SIGTERM, handleTerminationSignal);
+
+    // Κάθε φορά που βρίσκεται καλύτερη λύση την αποθηκεύουμε, ώστε να μη χαθεί αν λήξει ο χρόνος
+    options.on_improvement = [&](const Solution &solution)
+    {
+        exportCompletionMessage(instance_uid, solution, output_file);
+    };
 
     // Εκτέλεση τριγωνοποίησης
-    triangulate(points_x, points_y, region_boundary, additional_constraints);
+    Solution solution;
+    try
+    {
+        // Με --replay η λύση ξαναχτίζεται από το operation log χωρίς αναζήτηση
+        if (!replay_log.empty())
+            solution = replay(points_x, points_y, region_boundary, additional_constraints, replay_log, options.log);
+        else
+            solution = triangulate(points_x, points_y, region_boundary, additional_constraints, options);
+    }
+    catch (const invalid_argument &error)
+    {
+        cerr << "Error: " << error.what() << endl;
+        return 1;
+    }
     cout << "Όνομα που διαβάστηκε: " << instance_uid << endl;
-    exportCompletionMessage(instance_uid);
+    exportCompletionMessage(instance_uid, solution, output_file);
+    if (!metrics_file.empty())
+        exportMetrics(instance_uid, solution, metrics_file);
+    if (!strategy_stats_file.empty())
+        exportStrategyStats(instance_uid, solution, strategy_stats_file);
+    if (received_signal != 0)
+    {
+        cerr << "Terminated by signal " << received_signal << " after saving the best solution." << endl;
+        return 128 + received_signal;
+    }
     return 0;
 }
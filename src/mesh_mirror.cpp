@@ -0,0 +1,357 @@
+#include "triangulation_internal.h"
+#include <CGAL/centroid.h>
+#include <CGAL/convex_hull_2.h>
+#include <unordered_set>
+#include <algorithm>
+
+// Επίπεδο αντίγραφο του CDT για τους βρόχους ανάγνωσης (βλ. MeshMirror στο triangulation_internal.h)
+
+/////////////////////////////////////////////////////////
+
+// Νέα αρίθμηση όταν τα τρίγωνα στο τέλος (εκτός σειράς Hilbert) ξεπεράσουν το 1/8 των τριγώνων
+static const int32_t compaction_divisor = 8;
+
+// Η θέση του (x, y) στην καμπύλη Hilbert ενός πλέγματος 2^16 x 2^16
+static uint32_t hilbert_index(uint32_t x, uint32_t y)
+{
+    const uint32_t n = 1u << 16;
+    uint32_t d = 0;
+    for (uint32_t s = n / 2; s > 0; s /= 2)
+    {
+        uint32_t rx = (x & s) > 0;
+        uint32_t ry = (y & s) > 0;
+        d += s * s * ((3 * rx) ^ ry);
+        // Περιστροφή του τεταρτημορίου ώστε η καμπύλη να είναι συνεχής
+        if (ry == 0)
+        {
+            if (rx == 1)
+            {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            swap(x, y);
+        }
+    }
+    return d;
+}
+
+// Αντιστοίχιση συντεταγμένων στο πλέγμα της καμπύλης, με βάση το bounding box των κορυφών
+class HilbertGrid
+{
+public:
+    HilbertGrid(const vector<double> &x, const vector<double> &y)
+    {
+        min_x = *min_element(x.begin(), x.end());
+        min_y = *min_element(y.begin(), y.end());
+        double extent = max(*max_element(x.begin(), x.end()) - min_x, *max_element(y.begin(), y.end()) - min_y);
+        scale = extent > 0 ? 65535.0 / extent : 0.0;
+    }
+
+    uint32_t key(double px, double py) const
+    {
+        return hilbert_index(cell(px - min_x), cell(py - min_y));
+    }
+
+private:
+    uint32_t cell(double offset) const
+    {
+        return (uint32_t)min(65535.0, max(0.0, offset * scale));
+    }
+
+    double min_x, min_y, scale;
+};
+
+void MeshMirror::build(CDT &cdt, bool ordered)
+{
+    source = &cdt;
+    x.clear();
+    y.clear();
+    face_vertices.clear();
+    face_neighbors.clear();
+    face_class.clear();
+    vertex_handles.clear();
+    face_handles.clear();
+    free_faces.clear();
+    live_faces = 0;
+    appended = 0;
+    obtuse = 0;
+    cluster_valid = false;
+
+    for (auto vit = cdt.finite_vertices_begin(); vit != cdt.finite_vertices_end(); ++vit)
+    {
+        vit->info().index = x.size();
+        x.push_back(vit->point().x());
+        y.push_back(vit->point().y());
+        vertex_handles.push_back(vit);
+    }
+    cdt.infinite_vertex()->info().index = -1;
+    for (auto fit = cdt.all_faces_begin(); fit != cdt.all_faces_end(); ++fit)
+    {
+        if (cdt.is_infinite(fit))
+            fit->info().index = -1;
+        else
+            add_face(fit);
+    }
+    for (int32_t f = 0; f < live_faces; ++f)
+    {
+        write_face(cdt, f);
+    }
+    if (ordered)
+        compact();
+}
+
+// Οι κορυφές ταξινομούνται κατά το κλειδί Hilbert τους και τα τρίγωνα κατά το κλειδί του κέντρου βάρους τους.
+// Οι πίνακες αναδιατάσσονται και τα info των handles ξαναγράφονται. Οι κλάσεις δεν ξαναϋπολογίζονται και το cluster
+// της στρατηγικής 4 δεν αλλάζει (δεν εξαρτάται από την αρίθμηση).
+void MeshMirror::compact()
+{
+    appended = 0;
+    if (x.empty())
+        return;
+    HilbertGrid grid(x, y);
+
+    // Κλειδί και παλιός δείκτης στην ίδια τιμή, ώστε η ταξινόμηση να είναι ταξινόμηση ακεραίων
+    vector<uint64_t> order;
+    order.reserve(x.size());
+    for (size_t v = 0; v < x.size(); ++v)
+    {
+        order.push_back((uint64_t)grid.key(x[v], y[v]) << 32 | v);
+    }
+    sort(order.begin(), order.end());
+    vector<int32_t> new_vertex(x.size());
+    vector<double> sorted_x(x.size()), sorted_y(y.size());
+    vector<Vertex_handle> sorted_vertices(x.size());
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        uint32_t v = (uint32_t)order[i];
+        new_vertex[v] = i;
+        sorted_x[i] = x[v];
+        sorted_y[i] = y[v];
+        sorted_vertices[i] = vertex_handles[v];
+        sorted_vertices[i]->info().index = i;
+    }
+    x.swap(sorted_x);
+    y.swap(sorted_y);
+    vertex_handles.swap(sorted_vertices);
+
+    order.clear();
+    for (size_t f = 0; f < face_handles.size(); ++f)
+    {
+        if (face_handles[f] == Face_handle())
+            continue; // ελεύθερη θέση
+        double cx = 0, cy = 0;
+        for (int i = 0; i < 3; ++i)
+        {
+            cx += x[new_vertex[face_vertices[3 * f + i]]];
+            cy += y[new_vertex[face_vertices[3 * f + i]]];
+        }
+        order.push_back((uint64_t)grid.key(cx / 3, cy / 3) << 32 | f);
+    }
+    sort(order.begin(), order.end());
+    vector<int32_t> new_face(face_handles.size(), -1);
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        new_face[(uint32_t)order[i]] = i;
+    }
+    vector<int32_t> sorted_face_vertices(3 * order.size());
+    vector<int32_t> sorted_neighbors(3 * order.size());
+    vector<int8_t> sorted_class(order.size());
+    vector<Face_handle> sorted_faces(order.size());
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        uint32_t f = (uint32_t)order[i];
+        for (int k = 0; k < 3; ++k)
+        {
+            sorted_face_vertices[3 * i + k] = new_vertex[face_vertices[3 * f + k]];
+            int32_t n = face_neighbors[3 * f + k];
+            sorted_neighbors[3 * i + k] = n >= 0 ? new_face[n] : -1;
+        }
+        sorted_class[i] = face_class[f];
+        sorted_faces[i] = face_handles[f];
+        sorted_faces[i]->info().index = i;
+    }
+    face_vertices.swap(sorted_face_vertices);
+    face_neighbors.swap(sorted_neighbors);
+    face_class.swap(sorted_class);
+    face_handles.swap(sorted_faces);
+    free_faces.clear();
+}
+
+// Μια εισαγωγή στο CDT (insert_in_face/insert_in_edge και flips γύρω από τη νέα κορυφή) δεν καταστρέφει
+// τρίγωνα: τα νέα και όσα άλλαξαν κορυφές είναι όλα γύρω από τη v, ενώ στους γείτονές τους αλλάζουν μόνο οι
+// γείτονες. Αν το πλήθος των τριγώνων δεν συμφωνεί (π.χ. άλλη υλοποίηση της εισαγωγής), ξαναχτίζουμε.
+void MeshMirror::inserted(CDT &cdt, Vertex_handle v)
+{
+    if (v->info().index >= 0)
+        return; // το σημείο ήταν ήδη κορυφή, το cdt δεν άλλαξε
+    if (cdt.dimension() < 2)
+    {
+        build(cdt, true);
+        return;
+    }
+    v->info().index = x.size();
+    x.push_back(v->point().x());
+    y.push_back(v->point().y());
+    vertex_handles.push_back(v);
+    cluster_valid = false;
+
+    vector<Face_handle> star;
+    CDT::Face_circulator fc = cdt.incident_faces(v), done = fc;
+    do
+    {
+        star.push_back(fc);
+    } while (++fc != done);
+
+    // Πρώτα οι θέσεις όλων των τριγώνων, ώστε οι γείτονες να γράφονται με τους τελικούς δείκτες
+    vector<int32_t> changed;
+    for (Face_handle f : star)
+    {
+        int32_t i = f->info().index;
+        bool known = i >= 0 && i < (int32_t)face_handles.size() && face_handles[i] == f;
+        if (cdt.is_infinite(f))
+        {
+            if (known)
+                remove_face(i);
+            f->info().index = -1;
+        }
+        else if (known)
+        {
+            changed.push_back(i);
+        }
+        else
+        {
+            changed.push_back(add_face(f));
+            appended++;
+        }
+    }
+    for (int32_t f : changed)
+    {
+        write_face(cdt, f);
+        for (int i = 0; i < 3; ++i)
+        {
+            Face_handle n = face_handles[f]->neighbor(i);
+            if (!cdt.is_infinite(n) && !n->has_vertex(v))
+                write_face(cdt, n->info().index);
+        }
+    }
+
+    if (live_faces != (int32_t)cdt.number_of_faces())
+    {
+        STATS_COUNT(STAT_MIRROR_REBUILDS);
+        build(cdt, true);
+    }
+    else if (appended * compaction_divisor > live_faces)
+    {
+        compact();
+    }
+}
+
+vector<int32_t> MeshMirror::obtuse_faces() const
+{
+    vector<int32_t> faces;
+    faces.reserve(obtuse);
+    for (int32_t f = 0; f < (int32_t)face_class.size(); ++f)
+    {
+        if (face_class[f] >= 0)
+            faces.push_back(f);
+    }
+    return faces;
+}
+
+// Όπως το insert_Steiner_point_in_convex_polygons, αλλά με τη διάσχιση των γειτόνων στους πίνακες του mirror
+bool MeshMirror::cluster_centroid(Point &centroid) const
+{
+    if (cluster_valid)
+    {
+        centroid = cluster;
+        return cluster_found;
+    }
+    cluster_valid = true;
+    // Το πρώτο αμβλυγώνιο τρίγωνο με τη σειρά του cdt (όπως πριν από το mirror) και όχι της αρίθμησης, ώστε η
+    // στρατηγική 4 να μην εξαρτάται από το compact
+    int32_t first = -1;
+    for (auto fit = source->finite_faces_begin(); fit != source->finite_faces_end() && first < 0; ++fit)
+    {
+        if (face_class[fit->info().index] >= 0)
+            first = fit->info().index;
+    }
+    cluster_found = first >= 0;
+    if (!cluster_found)
+        return false;
+
+    unordered_set<int32_t> visited = {first};
+    vector<int32_t> stack = {first};
+    vector<Point> points;
+    while (!stack.empty())
+    {
+        int32_t f = stack.back();
+        stack.pop_back();
+        for (int i = 0; i < 3; ++i)
+        {
+            points.push_back(point(f, i));
+            int32_t n = face_neighbors[3 * f + i];
+            if (n >= 0 && face_class[n] >= 0 && visited.insert(n).second)
+                stack.push_back(n);
+        }
+    }
+    vector<Point> hull;
+    CGAL::convex_hull_2(points.begin(), points.end(), back_inserter(hull));
+    cluster = CGAL::centroid(hull.begin(), hull.end());
+    centroid = cluster;
+    return true;
+}
+
+int32_t MeshMirror::add_face(Face_handle f)
+{
+    int32_t i;
+    if (!free_faces.empty())
+    {
+        i = free_faces.back();
+        free_faces.pop_back();
+        face_handles[i] = f;
+    }
+    else
+    {
+        i = face_handles.size();
+        face_vertices.resize(face_vertices.size() + 3, -1);
+        face_neighbors.resize(face_neighbors.size() + 3, -1);
+        face_class.push_back(-1);
+        face_handles.push_back(f);
+    }
+    f->info().index = i;
+    live_faces++;
+    return i;
+}
+
+void MeshMirror::remove_face(int32_t f)
+{
+    if (face_class[f] >= 0)
+        obtuse--;
+    face_class[f] = -1;
+    for (int i = 0; i < 3; ++i)
+    {
+        face_vertices[3 * f + i] = -1;
+        face_neighbors[3 * f + i] = -1;
+    }
+    face_handles[f] = Face_handle();
+    free_faces.push_back(f);
+    live_faces--;
+}
+
+// Οι γωνίες ελέγχονται με τα predicates της CGAL όταν γράφεται το τρίγωνο, οπότε οι βρόχοι διαβάζουν μόνο την κλάση
+void MeshMirror::write_face(CDT &cdt, int32_t f)
+{
+    Face_handle h = face_handles[f];
+    for (int i = 0; i < 3; ++i)
+    {
+        face_vertices[3 * f + i] = h->vertex(i)->info().index;
+        Face_handle n = h->neighbor(i);
+        face_neighbors[3 * f + i] = cdt.is_infinite(n) ? -1 : n->info().index;
+    }
+    Point a = h->vertex(0)->point();
+    Point b = h->vertex(1)->point();
+    Point c = h->vertex(2)->point();
+    int new_class = is_obtuse_triangle(a, b, c) ? classify_face(cdt, h) : -1;
+    obtuse += (new_class >= 0) - (face_class[f] >= 0);
+    face_class[f] = new_class;
+}
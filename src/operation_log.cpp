@@ -0,0 +1,186 @@
+#include "triangulation_internal.h"
+#include <sstream>
+#include <iomanip>
+#include <stdexcept>
+
+// Operation log: κάθε αλλαγή της τριγωνοποίησης που οδήγησε στην τελική λύση, μία ανά γραμμή:
+//   insert x y strategy ax ay bx by cx cy
+//   flip px py qx qy
+//   move px py qx qy
+//   remove x y
+// Οι συντεταγμένες γράφονται με πλήρη ακρίβεια, ώστε το replay να ξαναχτίζει ακριβώς το ίδιο CDT.
+
+/////////////////////////////////////////////////////////
+
+Operation insert_operation(const Point &p, int strategy, Face_handle face)
+{
+    Operation operation = {Operation::INSERT, p, p, strategy, {face->vertex(0)->point(), face->vertex(1)->point(), face->vertex(2)->point()}};
+    return operation;
+}
+
+// Εισαγωγή που δεν προήλθε από στρατηγική (π.χ. επαναφορά ενός σημείου που αφαιρέθηκε)
+Operation insert_operation(const Point &p)
+{
+    Operation operation = {Operation::INSERT, p, p, -1, {p, p, p}};
+    return operation;
+}
+
+Operation flip_operation(const Point &p, const Point &q)
+{
+    Operation operation = {Operation::FLIP, p, q, -1, {p, p, p}};
+    return operation;
+}
+
+Operation move_operation(const Point &from, const Point &to)
+{
+    Operation operation = {Operation::MOVE, from, to, -1, {from, from, from}};
+    return operation;
+}
+
+Operation remove_operation(const Point &p)
+{
+    Operation operation = {Operation::REMOVE, p, p, -1, {p, p, p}};
+    return operation;
+}
+
+/////////////////////////////////////////////////////////
+
+// Μία γραμμή του log για την αλλαγή (χωρίς αλλαγή γραμμής στο τέλος)
+string format_operation(const Operation &operation)
+{
+    ostringstream line;
+    line << setprecision(17);
+    switch (operation.type)
+    {
+    case Operation::INSERT:
+        line << "insert " << operation.p.x() << " " << operation.p.y() << " " << operation.strategy;
+        for (const Point &corner : operation.face)
+        {
+            line << " " << corner.x() << " " << corner.y();
+        }
+        break;
+    case Operation::FLIP:
+        line << "flip " << operation.p.x() << " " << operation.p.y() << " " << operation.q.x() << " " << operation.q.y();
+        break;
+    case Operation::MOVE:
+        line << "move " << operation.p.x() << " " << operation.p.y() << " " << operation.q.x() << " " << operation.q.y();
+        break;
+    case Operation::REMOVE:
+        line << "remove " << operation.p.x() << " " << operation.p.y();
+        break;
+    }
+    return line.str();
+}
+
+// Ανάγνωση μιας γραμμής του log. Επιστρέφει false αν η γραμμή δεν είναι έγκυρη.
+bool parse_operation(const string &line, Operation &operation)
+{
+    istringstream stream(line);
+    string type;
+    double px, py, qx, qy;
+    if (!(stream >> type >> px >> py))
+        return false;
+    if (type == "insert")
+    {
+        int strategy;
+        double corners[6];
+        stream >> strategy >> corners[0] >> corners[1] >> corners[2] >> corners[3] >> corners[4] >> corners[5];
+        Operation insert = {Operation::INSERT, Point(px, py), Point(px, py), strategy,
+                            {Point(corners[0], corners[1]), Point(corners[2], corners[3]), Point(corners[4], corners[5])}};
+        operation = insert;
+    }
+    else if (type == "flip" || type == "move")
+    {
+        stream >> qx >> qy;
+        operation = type == "flip" ? flip_operation(Point(px, py), Point(qx, qy)) : move_operation(Point(px, py), Point(qx, qy));
+    }
+    else if (type == "remove")
+    {
+        operation = remove_operation(Point(px, py));
+    }
+    else
+    {
+        return false;
+    }
+    return bool(stream);
+}
+
+bool write_operation_log(const string &filename, const vector<Operation> &operations)
+{
+    ofstream file(filename);
+    if (!file.is_open())
+        return false;
+    for (const Operation &operation : operations)
+    {
+        file << format_operation(operation) << "\n";
+    }
+    file.close();
+    return bool(file);
+}
+
+vector<Operation> read_operation_log(const string &filename)
+{
+    ifstream file(filename);
+    if (!file.is_open())
+        throw invalid_argument("Could not open the operation log '" + filename + "'.");
+
+    vector<Operation> operations;
+    string line;
+    int line_number = 0;
+    while (getline(file, line))
+    {
+        line_number++;
+        if (line.empty() || line[0] == '#')
+            continue;
+        Operation operation;
+        if (!parse_operation(line, operation))
+            throw invalid_argument("Invalid operation at line " + to_string(line_number) + " of '" + filename + "'.");
+        operations.push_back(operation);
+    }
+    return operations;
+}
+
+// Η κορυφή του cdt στη θέση p, αν υπάρχει
+static bool find_vertex(CDT &cdt, const Point &p, Vertex_handle &v)
+{
+    CDT::Locate_type lt;
+    int li;
+    Face_handle f = cdt.locate(p, lt, li);
+    if (lt != CDT::VERTEX)
+        return false;
+    v = f->vertex(li);
+    return true;
+}
+
+// Εφαρμογή μιας αλλαγής στο cdt. Επιστρέφει false αν δεν εφαρμόζεται (π.χ. η ακμή ή η κορυφή δεν υπάρχει).
+bool apply_operation(CDT &cdt, const Operation &operation)
+{
+    Vertex_handle u, v;
+    switch (operation.type)
+    {
+    case Operation::INSERT:
+        cdt.insert(operation.p);
+        return true;
+    case Operation::FLIP:
+    {
+        Face_handle f;
+        int i;
+        if (!find_vertex(cdt, operation.p, u) || !find_vertex(cdt, operation.q, v) || !cdt.is_edge(u, v, f, i) ||
+            cdt.is_constrained(CDT::Edge(f, i)))
+            return false;
+        cdt.flip(f, i);
+        return true;
+    }
+    case Operation::MOVE:
+        if (!find_vertex(cdt, operation.p, v) || cdt.are_there_incident_constraints(v))
+            return false;
+        relocate_vertex(cdt, v, operation.q);
+        return true;
+    case Operation::REMOVE:
+        if (!find_vertex(cdt, operation.p, v) || cdt.are_there_incident_constraints(v))
+            return false;
+        cdt.remove(v);
+        return true;
+    }
+    return false;
+}
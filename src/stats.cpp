@@ -0,0 +1,81 @@
+#include "stats.h"
+
+static const char *const counter_names[STAT_COUNTER_COUNT] = {
+    "search_iterations",
+    "candidate_evaluations",
+    "cdt_copies",
+    "insertions",
+    "out_of_domain_candidates",
+    "scratch_resyncs",
+    "mirror_rebuilds",
+};
+
+static const char *const timer_names[STAT_TIMER_COUNT] = {
+    "json_parse",
+    "cdt_build",
+    "initial_count",
+    "edge_flips",
+    "search",
+    "post_processing",
+    "export",
+};
+
+#ifdef TRIANGULATION_STATS
+
+atomic<long long> stats_counters[STAT_COUNTER_COUNT];
+atomic<long long> stats_timer_ns[STAT_TIMER_COUNT];
+atomic<long long> stats_timer_calls[STAT_TIMER_COUNT];
+
+bool stats_enabled()
+{
+    return true;
+}
+
+long long stats_counter_value(StatsCounter counter)
+{
+    return stats_counters[counter].load();
+}
+
+double stats_timer_ms(StatsTimer timer)
+{
+    return stats_timer_ns[timer].load() / 1e6;
+}
+
+long long stats_timer_calls_value(StatsTimer timer)
+{
+    return stats_timer_calls[timer].load();
+}
+
+#else
+
+bool stats_enabled()
+{
+    return false;
+}
+
+long long stats_counter_value(StatsCounter)
+{
+    return 0;
+}
+
+double stats_timer_ms(StatsTimer)
+{
+    return 0;
+}
+
+long long stats_timer_calls_value(StatsTimer)
+{
+    return 0;
+}
+
+#endif
+
+const char *stats_counter_name(StatsCounter counter)
+{
+    return counter_names[counter];
+}
+
+const char *stats_timer_name(StatsTimer timer)
+{
+    return timer_names[timer];
+}
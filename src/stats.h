@@ -0,0 +1,81 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <atomic>
+#include <chrono>
+
+using namespace std;
+
+// Χρονόμετρα και μετρητές για τις φάσεις του solver. Ενεργοποιούνται μόνο με -DTRIANGULATION_STATS
+// (option TRIANGULATION_STATS στο CMake), αλλιώς οι μακροεντολές δεν παράγουν κανέναν κώδικα.
+
+enum StatsCounter
+{
+    STAT_SEARCH_ITERATIONS,     // επαναλήψεις των engines (επεκτάσεις του BFS, γύροι του greedy, βήματα του annealing)
+    STAT_CANDIDATE_EVALUATIONS, // υποψήφια σημεία που αξιολογήθηκαν (με εισαγωγή ή με εκτίμηση)
+    STAT_CDT_COPIES,            // αντίγραφα ολόκληρου του CDT για δοκιμαστικές εισαγωγές
+    STAT_INSERTIONS,            // εισαγωγές σημείων σε ολόκληρο το CDT
+    STAT_OUT_OF_DOMAIN,         // υποψήφια σημεία εκτός της περιοχής που απορρίφθηκαν
+    STAT_SCRATCH_RESYNCS,       // δοκιμές όπου το ScratchCDT δεν επανήλθε ακριβώς και ξανασυγχρονίστηκε
+    STAT_MIRROR_REBUILDS,       // εισαγωγές μετά από τις οποίες το MeshMirror χτίστηκε από την αρχή
+    STAT_COUNTER_COUNT
+};
+
+enum StatsTimer
+{
+    STAT_TIMER_JSON_PARSE,      // ανάγνωση του instance
+    STAT_TIMER_CDT_BUILD,       // κατασκευή του αρχικού CDT με τα constraints
+    STAT_TIMER_INITIAL_COUNT,   // αρχική καταμέτρηση των αμβλυγώνιων
+    STAT_TIMER_EDGE_FLIPS,      // flips πριν από την αναζήτηση
+    STAT_TIMER_SEARCH,          // το engine αναζήτησης
+    STAT_TIMER_POST_PROCESSING, // μετακίνηση και αφαίρεση Steiner points
+    STAT_TIMER_EXPORT,          // εγγραφή των λύσεων
+    STAT_TIMER_COUNT
+};
+
+#ifdef TRIANGULATION_STATS
+
+extern atomic<long long> stats_counters[STAT_COUNTER_COUNT];
+extern atomic<long long> stats_timer_ns[STAT_TIMER_COUNT];
+extern atomic<long long> stats_timer_calls[STAT_TIMER_COUNT];
+
+// Προσθέτει τη διάρκεια της εμβέλειάς του στο αντίστοιχο χρονόμετρο
+class ScopedStatsTimer
+{
+public:
+    explicit ScopedStatsTimer(StatsTimer timer) : timer(timer), start(chrono::steady_clock::now()) {}
+    ~ScopedStatsTimer()
+    {
+        long long ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+        stats_timer_ns[timer].fetch_add(ns, memory_order_relaxed);
+        stats_timer_calls[timer].fetch_add(1, memory_order_relaxed);
+    }
+
+private:
+    StatsTimer timer;
+    chrono::steady_clock::time_point start;
+};
+
+#define STATS_CONCAT_(a, b) a##b
+#define STATS_CONCAT(a, b) STATS_CONCAT_(a, b)
+#define STATS_ADD(counter, n) stats_counters[counter].fetch_add((n), memory_order_relaxed)
+#define STATS_COUNT(counter) STATS_ADD(counter, 1)
+#define STATS_TIMER(timer) ScopedStatsTimer STATS_CONCAT(stats_timer_, __LINE__)(timer)
+
+#else
+
+#define STATS_ADD(counter, n) ((void)0)
+#define STATS_COUNT(counter) ((void)0)
+#define STATS_TIMER(timer) ((void)0)
+
+#endif
+
+// Ανάγνωση των μετρήσεων (μηδενικές αν η instrumentation είναι απενεργοποιημένη)
+bool stats_enabled();
+const char *stats_counter_name(StatsCounter counter);
+const char *stats_timer_name(StatsTimer timer);
+long long stats_counter_value(StatsCounter counter);
+double stats_timer_ms(StatsTimer timer);
+long long stats_timer_calls_value(StatsTimer timer);
+
+#endif
@@ -0,0 +1,149 @@
+#include "triangulation_internal.h"
+#include <algorithm>
+#include <cmath>
+
+// Προσαρμοστική επιλογή στρατηγικής (multi-armed bandit, UCB1)
+
+/////////////////////////////////////////////////////////
+
+// Κλάση ενός αμβλυγώνιου τριγώνου: αν η αμβλεία γωνία είναι πάνω από 120 μοίρες και
+// αν η απέναντι πλευρά (εκεί που καταλήγουν π.χ. η προβολή και το μέσο) έχει constraint
+int classify_face(CDT &cdt, Face_handle face)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        Point apex = face->vertex(i)->point();
+        Point u = face->vertex(cdt.ccw(i))->point();
+        Point w = face->vertex(cdt.cw(i))->point();
+        if (CGAL::angle(u, apex, w) != CGAL::OBTUSE)
+            continue;
+        double ux = u.x() - apex.x(), uy = u.y() - apex.y();
+        double wx = w.x() - apex.x(), wy = w.y() - apex.y();
+        double cosine = (ux * wx + uy * wy) / sqrt((ux * ux + uy * uy) * (wx * wx + wy * wy));
+        bool wide = cosine < -0.5;
+        return (wide ? 1 : 0) + (face->is_constrained(i) ? 2 : 0);
+    }
+    return 0;
+}
+
+StrategySelector::StrategySelector()
+{
+    for (int c = 0; c < class_count; ++c)
+    {
+        for (int s = 0; s < strategy_count; ++s)
+        {
+            attempts[c][s] = 0;
+            successes[c][s] = 0;
+        }
+    }
+}
+
+// Οι στρατηγικές ταξινομημένες κατά UCB1: μέση επιτυχία + sqrt(2 ln N / n).
+// Όσες δεν έχουν δοκιμαστεί ακόμη σε αυτή την κλάση έρχονται πρώτες.
+vector<int> StrategySelector::order(int face_class)
+{
+    int n[strategy_count], wins[strategy_count];
+    int total = 0;
+    for (int s = 0; s < strategy_count; ++s)
+    {
+        n[s] = attempts[face_class][s].load(memory_order_relaxed);
+        wins[s] = successes[face_class][s].load(memory_order_relaxed);
+        total += n[s];
+    }
+    double score[strategy_count];
+    for (int s = 0; s < strategy_count; ++s)
+    {
+        score[s] = n[s] == 0 ? INFINITY : double(wins[s]) / n[s] + sqrt(2.0 * log(double(total)) / n[s]);
+    }
+
+    vector<int> strategies;
+    for (int s = 0; s < strategy_count; ++s)
+    {
+        strategies.push_back(s);
+    }
+    stable_sort(strategies.begin(), strategies.end(), [&](int a, int b)
+                { return score[a] > score[b]; });
+    return strategies;
+}
+
+void StrategySelector::update(int face_class, int strategy, bool success)
+{
+    attempts[face_class][strategy].fetch_add(1, memory_order_relaxed);
+    if (success)
+        successes[face_class][strategy].fetch_add(1, memory_order_relaxed);
+}
+
+void StrategySelector::save(vector<int> &saved_attempts, vector<int> &saved_successes)
+{
+    saved_attempts.clear();
+    saved_successes.clear();
+    for (int c = 0; c < class_count; ++c)
+    {
+        for (int s = 0; s < strategy_count; ++s)
+        {
+            saved_attempts.push_back(attempts[c][s].load());
+            saved_successes.push_back(successes[c][s].load());
+        }
+    }
+}
+
+void StrategySelector::restore(const vector<int> &saved_attempts, const vector<int> &saved_successes)
+{
+    if (saved_attempts.size() != size_t(class_count * strategy_count) || saved_successes.size() != saved_attempts.size())
+        return;
+    for (int c = 0; c < class_count; ++c)
+    {
+        for (int s = 0; s < strategy_count; ++s)
+        {
+            attempts[c][s] = saved_attempts[c * strategy_count + s];
+            successes[c][s] = saved_successes[c * strategy_count + s];
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////
+
+StrategyStatistics::StrategyStatistics()
+{
+    for (int s = 0; s < StrategySelector::strategy_count; ++s)
+    {
+        attempts[s] = 0;
+        out_of_domain[s] = 0;
+        evaluations[s] = 0;
+        delta_sum[s] = 0;
+        acceptances[s] = 0;
+        time_ns[s] = 0;
+    }
+}
+
+void StrategyStatistics::attempt(int strategy, long long elapsed_ns, bool in_domain)
+{
+    attempts[strategy].fetch_add(1, memory_order_relaxed);
+    time_ns[strategy].fetch_add(elapsed_ns, memory_order_relaxed);
+    if (!in_domain)
+        out_of_domain[strategy].fetch_add(1, memory_order_relaxed);
+}
+
+void StrategyStatistics::evaluated(int strategy, int delta)
+{
+    evaluations[strategy].fetch_add(1, memory_order_relaxed);
+    delta_sum[strategy].fetch_add(delta, memory_order_relaxed);
+}
+
+void StrategyStatistics::accepted(int strategy)
+{
+    acceptances[strategy].fetch_add(1, memory_order_relaxed);
+}
+
+vector<StrategyReport> StrategyStatistics::report() const
+{
+    vector<StrategyReport> reports;
+    for (int s = 0; s < StrategySelector::strategy_count; ++s)
+    {
+        long long n = evaluations[s].load();
+        StrategyReport report = {s, attempts[s].load(), out_of_domain[s].load(), n,
+                                 n > 0 ? double(delta_sum[s].load()) / n : 0.0, acceptances[s].load(), time_ns[s].load() / 1e6};
+        reports.push_back(report);
+    }
+    return reports;
+}
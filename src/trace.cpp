@@ -0,0 +1,71 @@
+#include "triangulation_internal.h"
+#include <unistd.h>
+
+// Χρονοσειρά σύγκλισης της αναζήτησης (βλ. ConvergenceTrace)
+
+/////////////////////////////////////////////////////////
+
+// Η τρέχουσα μνήμη (resident set) της διεργασίας σε KB από το /proc/self/statm (0 αν δεν είναι διαθέσιμο)
+static long long resident_set_kb()
+{
+    ifstream statm("/proc/self/statm");
+    long long size = 0, resident = 0;
+    if (!(statm >> size >> resident))
+        return 0;
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+static bool ends_with(const string &text, const string &suffix)
+{
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+ConvergenceTrace::ConvergenceTrace(const string &filename, long long interval_ms)
+    : file(filename), jsonl(ends_with(filename, ".jsonl")), start(chrono::steady_clock::now()), interval_ms(interval_ms),
+      iterations(0), next_sample_ms(0), last_obtuse(-1), last_steiner(-1)
+{
+    if (file.is_open() && !jsonl)
+        file << "elapsed_ms,iteration,best_obtuse,steiner_points,frontier_size,rss_kb" << endl;
+}
+
+bool ConvergenceTrace::is_open() const
+{
+    return file.is_open();
+}
+
+void ConvergenceTrace::iteration(const Incumbent &incumbent, size_t frontier_size)
+{
+    iterations.fetch_add(1, memory_order_relaxed);
+    long long elapsed_ms = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    if (elapsed_ms >= next_sample_ms.load(memory_order_relaxed) || !incumbent.holds(last_obtuse, last_steiner))
+        write(incumbent, frontier_size);
+}
+
+// Τελευταίο δείγμα με την τελική λύση
+void ConvergenceTrace::finish(const Incumbent &incumbent)
+{
+    write(incumbent, 0);
+}
+
+void ConvergenceTrace::write(const Incumbent &incumbent, size_t frontier_size)
+{
+    lock_guard<mutex> guard(lock);
+    long long elapsed_ms = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    int obtuse, steiner;
+    incumbent.load(obtuse, steiner);
+    last_obtuse = obtuse;
+    last_steiner = steiner;
+    next_sample_ms = elapsed_ms + interval_ms;
+
+    long long iteration = iterations.load();
+    long long rss_kb = resident_set_kb();
+    if (jsonl)
+    {
+        file << "{\"elapsed_ms\": " << elapsed_ms << ", \"iteration\": " << iteration << ", \"best_obtuse\": " << obtuse
+             << ", \"steiner_points\": " << steiner << ", \"frontier_size\": " << frontier_size << ", \"rss_kb\": " << rss_kb << "}" << endl;
+    }
+    else
+    {
+        file << elapsed_ms << "," << iteration << "," << obtuse << "," << steiner << "," << frontier_size << "," << rss_kb << endl;
+    }
+}
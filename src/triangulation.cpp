@@ -1,30 +1,23 @@
-#include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
-#include <CGAL/Constrained_Delaunay_triangulation_2.h>
+#include "triangulation_internal.h"
 #include <CGAL/mark_domain_in_triangulation.h>
 #include <CGAL/Delaunay_mesher_2.h>
-#include "triangulation.h"
-#include <CGAL/Polygon_2.h>
 #include <CGAL/draw_triangulation_2.h>
 #include <CGAL/centroid.h>
 #include <CGAL/convex_hull_2.h>
+#include <CGAL/spatial_sort.h>
+#include <CGAL/Spatial_sort_traits_adapter_2.h>
+#include <boost/property_map/property_map.hpp>
 #include <unordered_map>
 #include <cmath>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <exception>
+#include <algorithm>
+#include <climits>
+#include <memory>
+#include <deque>
 
-//////////////////////////////////////////////////////////
-
-// kernel
-typedef CGAL::Exact_predicates_inexact_constructions_kernel K;
-typedef CGAL::Simple_cartesian<double> Kernel;
-typedef CGAL::Triangulation_vertex_base_2<K> Vb;
-typedef CGAL::Constrained_triangulation_face_base_2<K> Fb;
-typedef CGAL::Triangulation_data_structure_2<Vb, Fb> Tds;
-typedef CGAL::Exact_predicates_tag Itag;
-typedef CGAL::Constrained_Delaunay_triangulation_2<K, Tds, Itag> CDT;
-typedef K::Line_2 Line;
-typedef CDT::Point Point;
-typedef CGAL::Polygon_2<K> Polygon_2;
-typedef CDT::Face_handle Face_handle;
-using namespace std;
 ///////////////////////////////////////////////////
 
 int is_obtuse_angle(Point &A, Point &B, Point &C)
@@ -51,6 +44,79 @@ int count_Obtuse_Angles(CDT &cdt)
     return count;
 }
 
+int is_obtuse_triangle(Point &a, Point &b, Point &c)
+{
+    return is_obtuse_angle(a, b, c) || is_obtuse_angle(b, c, a) || is_obtuse_angle(c, a, b);
+}
+
+// Επιστρέφει όλα τα αμβλυγώνια τρίγωνα της τριγωνοποίησης
+vector<Face_handle> find_obtuse_faces(CDT &cdt)
+{
+    vector<Face_handle> faces;
+    for (auto fit = cdt.finite_faces_begin(); fit != cdt.finite_faces_end(); ++fit)
+    {
+        Point a = fit->vertex(0)->point();
+        Point b = fit->vertex(1)->point();
+        Point c = fit->vertex(2)->point();
+        if (is_obtuse_triangle(a, b, c))
+        {
+            faces.push_back(fit);
+        }
+    }
+    return faces;
+}
+
+// Έλεγχος αν ένα σημείο είναι μέσα ή πάνω στο όριο της περιοχής
+bool is_inside_region(Polygon_2 &region_boundary, Point &p)
+{
+    return region_boundary.bounded_side(p) != CGAL::ON_UNBOUNDED_SIDE;
+}
+
+// Μετατροπή μιας τριγωνοποίησης σε λύση CG:SHOP: τα σημεία που δεν ανήκουν στα αρχικά είναι Steiner points
+// και κρατάμε μόνο τις ακμές των τριγώνων που βρίσκονται μέσα στο region_boundary
+Solution build_solution(const CDT &cdt, const InstancePoints &points, const Polygon_2 &region_boundary, int obtuse_count)
+{
+    Solution solution;
+    solution.obtuse_count = obtuse_count;
+
+    map<Point, int> index;
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        index[points[i]] = i;
+    }
+    for (auto vit = cdt.finite_vertices_begin(); vit != cdt.finite_vertices_end(); ++vit)
+    {
+        if (index.find(vit->point()) == index.end())
+        {
+            index[vit->point()] = points.size() + solution.steiner_points_x.size();
+            solution.steiner_points_x.push_back(vit->point().x());
+            solution.steiner_points_y.push_back(vit->point().y());
+        }
+    }
+    solution.steiner_points = solution.steiner_points_x.size();
+
+    for (auto eit = cdt.finite_edges_begin(); eit != cdt.finite_edges_end(); ++eit)
+    {
+        Face_handle f = eit->first;
+        int i = eit->second;
+        Face_handle g = f->neighbor(i);
+        bool inside = false;
+        for (Face_handle face : {f, g})
+        {
+            if (!cdt.is_infinite(face))
+            {
+                Point c = CGAL::centroid(face->vertex(0)->point(), face->vertex(1)->point(), face->vertex(2)->point());
+                inside = inside || region_boundary.bounded_side(c) != CGAL::ON_UNBOUNDED_SIDE;
+            }
+        }
+        if (inside)
+        {
+            solution.edges.push_back({index[f->vertex(cdt.cw(i))->point()], index[f->vertex(cdt.ccw(i))->point()]});
+        }
+    }
+    return solution;
+}
+
 Point project_point(Point &A, Point &B, Point &P)
 { // επιστρέφει την προβολή από ένα σημείο P στην πλευρά που σχηματίζουν τα Α-Β
     Line line(A, B);
@@ -126,20 +192,23 @@ Point insert_Steiner_point_in_convex_polygons(CDT &cdt, Polygon_2 &region_bounda
 
 ///////////////////////////////////////////////////////////
 
-// Συνάρτηση που επιστρέφει σημείο Steiner για μία από τις 5 στρατηγικές
-Point select_steiner_point(Point &a, Point &b, Point &c, int strategy, CDT &cdt, Polygon_2 region_boundary)
+// Οι στρατηγικές 0-3 εξαρτώνται μόνο από το τρίγωνο. Επιστρέφει false για τη στρατηγική 4 (και για την 3 αν
+// το τρίγωνο δεν έχει αμβλεία γωνία), που παίρνει το σημείο από το cluster αμβλυγώνιων της τριγωνοποίησης.
+static bool triangle_steiner_point(Point &a, Point &b, Point &c, int strategy, Point &steiner)
 {
     switch (strategy)
     {
     case 0:
     { // Περίκεντρο check
-        return circumcenter(a, b, c);
+        steiner = circumcenter(a, b, c);
+        return true;
     }
     case 1:
     { // Κέντρο βάρους ενός τριγώνου
         double cx = (a.x() + b.x() + c.x()) / 3.0;
         double cy = (a.y() + b.y() + c.y()) / 3.0;
-        return Point(cx, cy);
+        steiner = Point(cx, cy);
+        return true;
     }
     case 2:
     { // Μέσο της μεγαλύτερης ακμής check
@@ -148,64 +217,82 @@ Point select_steiner_point(Point &a, Point &b, Point &c, int strategy, CDT &cdt,
         double d_ca = squared_distance(c, a);
         if (d_ab >= d_bc && d_ab >= d_ca)
         {
-            return midpoint(a, b);
+            steiner = midpoint(a, b);
         }
         else if (d_bc >= d_ab && d_bc >= d_ca)
         {
-            return midpoint(b, c);
+            steiner = midpoint(b, c);
         }
         else
         {
-            return midpoint(c, a);
+            steiner = midpoint(c, a);
         }
+        return true;
     }
     case 3:
     { // Προβολή της κορυφής της αμβλείας γωνίας στην απέναντι πλευρά
         if (is_obtuse_angle(b, a, c))
         {
-            return project_point(b, c, a); // προβολή του A στην πλευρά B-C
+            steiner = project_point(b, c, a); // προβολή του A στην πλευρά B-C
+            return true;
         }
         else if (is_obtuse_angle(a, b, c))
         {
-            return project_point(a, c, b); // του B στην πλευρά A-C
+            steiner = project_point(a, c, b); // του B στην πλευρά A-C
+            return true;
         }
         else if (is_obtuse_angle(a, c, b))
         {
-            return project_point(a, b, c); // και του C στην πλευρά AB
+            steiner = project_point(a, b, c); // και του C στην πλευρά AB
+            return true;
         }
+        return false;
     }
     case 4:
-    {
-        return insert_Steiner_point_in_convex_polygons(cdt, region_boundary);
-    }
+        return false;
     default:
         throw invalid_argument("Invalid strategy selected.");
     }
 }
 
-////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////
+// Συνάρτηση που επιστρέφει σημείο Steiner για μία από τις 5 στρατηγικές
+Point select_steiner_point(Point &a, Point &b, Point &c, int strategy, CDT &cdt, Polygon_2 region_boundary)
+{
+    Point steiner;
+    if (triangle_steiner_point(a, b, c, strategy, steiner))
+        return steiner;
+    return insert_Steiner_point_in_convex_polygons(cdt, region_boundary);
+}
 
-/////////////////////////////////////////////////////////
+// Το ίδιο με τη στρατηγική 4 από το MeshMirror του cdt
+Point select_steiner_point(Point &a, Point &b, Point &c, int strategy, const MeshMirror &mesh)
+{
+    Point steiner;
+    if (triangle_steiner_point(a, b, c, strategy, steiner))
+        return steiner;
+    if (!mesh.cluster_centroid(steiner))
+        steiner = CGAL::centroid(a, b, c); // χωρίς αμβλυγώνια δεν υπάρχει cluster
+    return steiner;
+}
 
-// State definition
-struct State
+// Υποψήφιο σημείο μιας στρατηγικής για τα engines: καταγράφει τον χρόνο υπολογισμού και αν το σημείο
+// απορρίφθηκε επειδή είναι εκτός περιοχής. Επιστρέφει false για σημεία εκτός περιοχής.
+bool propose_steiner_point(SearchContext &context, Point &a, Point &b, Point &c, int strategy, const MeshMirror &mesh, Point &steiner)
 {
-    CDT cdt;
-    int obtuse_count;
-    int steiner_points;
-    std::vector<Point> steiner_locations;
-    std::vector<int> strategies;
+    auto start = chrono::steady_clock::now();
+    steiner = select_steiner_point(a, b, c, strategy, mesh);
+    long long elapsed_ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+    bool in_domain = is_inside_region(context.region_boundary, steiner);
+    context.strategy_stats.attempt(strategy, elapsed_ns, in_domain);
+    if (!in_domain)
+        STATS_COUNT(STAT_OUT_OF_DOMAIN);
+    return in_domain;
+}
 
-    // Εδώ χρησιμοποιούμε την compareStates για τη σύγκριση
-    bool operator==(const State &other) const
-    {
-        return obtuse_count == other.obtuse_count &&
-               steiner_points == other.steiner_points &&
-               steiner_locations == other.steiner_locations &&
-               strategies == other.strategies;
-    }
-};
+////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////
 
 // Συνάρτηση για τη σύγκριση δύο καταστάσεων State
 bool compareStates(const State &a, const State &b)
@@ -216,84 +303,188 @@ bool compareStates(const State &a, const State &b)
            a.strategies == b.strategies;
 }
 
-struct StateHash
+State bfs_triangulation(const State &initial_state, SearchContext &context, mt19937 &)
 {
-    std::size_t operator()(const State &s) const
-    {
-        size_t hash_val = 0;
-        // Hash για obtuse_count, steiner_points, και άλλα χαρακτηριστικά
-        hash_val ^= hash<int>{}(s.obtuse_count) + 0x9e3779b9 + (hash_val << 6) + (hash_val >> 2);
-        hash_val ^= hash<int>{}(s.steiner_points) + 0x9e3779b9 + (hash_val << 6) + (hash_val >> 2);
-        for (const auto &loc : s.steiner_locations)
-        {
-            hash_val ^= hash<double>{}(loc.x()) + 0x9e3779b9 + (hash_val << 6) + (hash_val >> 2);
-            hash_val ^= hash<double>{}(loc.y()) + 0x9e3779b9 + (hash_val << 6) + (hash_val >> 2);
-        }
-        return hash_val;
-    }
-};
+    const StopCondition &stop = context.stop;
+    int max_depth = context.options.max_depth;
+    int max_iterations = context.options.max_iterations;
 
-State bfs_triangulation(CDT &initial_cdt, Polygon_2 &convex_hull, int &best_obtuse, CDT &best_cdt, int max_depth, int max_iterations)
-{
-    queue<State> queue;
+    deque<State> queue; // deque ώστε τα checkpoints να διατρέχουν την ουρά
     unordered_set<State, StateHash> visited; // Χρησιμοποιούμε custom hash για State
-    // Αρχικοποίηση με την αρχική κατάσταση
-    State initial_state = {initial_cdt, count_Obtuse_Angles(initial_cdt), 0, {}, {}};
+    // Αρχικοποίηση με την αρχική κατάσταση ή με την ουρά ενός checkpoint
     State best_state = initial_state;
-    queue.push(initial_state);
-    visited.insert(initial_state);
     int iteration_count = 0;
-    best_cdt = initial_cdt;
+    if (context.resume)
+    {
+        best_state = rebuild_state(initial_state, context.resume->best);
+        for (const vector<Operation> &operations : context.resume->frontier)
+        {
+            State state = rebuild_state(initial_state, operations);
+            if (visited.insert(state).second)
+                queue.push_back(state);
+        }
+        iteration_count = context.resume->iteration;
+    }
+    else
+    {
+        queue.push_back(initial_state);
+        visited.insert(initial_state);
+    }
+    context.report(best_state);
+    ScratchCDT scratch; // δοκιμαστικές εισαγωγές, η μνήμη του ξαναχρησιμοποιείται σε όλη την αναζήτηση
+    MeshMirror mesh;    // το cdt της κατάστασης που επεκτείνεται, για την καταμέτρηση και τα υποψήφια σημεία
 
-    // Εξερεύνηση μέσω BFS
-    while (!queue.empty() && iteration_count < max_iterations)
+    // Εξερεύνηση μέσω BFS (μέχρι να λήξει το χρονικό όριο)
+    while (!queue.empty() && iteration_count < max_iterations && !stop.should_stop())
     {
         State current_state = queue.front();
-        queue.pop();
+        queue.pop_front();
+        STATS_COUNT(STAT_SEARCH_ITERATIONS);
+        context.trace_iteration(queue.size());
+        // Στο checkpoint μπαίνει πρώτη η τρέχουσα κατάσταση, που δεν έχει επεκταθεί ακόμη
+        if (context.checkpoint_due())
+        {
+            Checkpoint checkpoint;
+            checkpoint.best = best_state.operations;
+            checkpoint.frontier.push_back(current_state.operations);
+            for (const State &state : queue)
+            {
+                checkpoint.frontier.push_back(state.operations);
+            }
+            checkpoint.iteration = iteration_count;
+            context.checkpoint(checkpoint);
+        }
+        // Με εκτιμήσεις (predict/submesh) το πλήθος των καταστάσεων στην ουρά είναι εκτίμηση, οπότε το διορθώνουμε
+        mesh.build(current_state.cdt, false);
+        if (context.evaluation != FULL_EVALUATION)
+            current_state.obtuse_count = mesh.obtuse_count();
         // Αν η τρέχουσα κατάσταση είναι βέλτιστη, ενημερώνουμε τη βέλτιστη λύση
         if (current_state.obtuse_count < best_state.obtuse_count)
         {
-            best_cdt = current_state.cdt;
             best_state = current_state;
             iteration_count = 0; // Επαναφορά του μετρητή επαναλήψεων επειδή βελτιώθηκε
+            context.report(best_state);
         }
         // Αν φτάσουμε στο μέγιστο βάθος ή δεν έχουμε άλλες αμβλείες γωνίες, σταματάμε
         if (current_state.steiner_points >= max_depth || best_state.obtuse_count == 0)
             return best_state;
-        // Εξερεύνηση όλων των τριγώνων με αμβλείες γωνίες
-        for (auto fit = current_state.cdt.finite_faces_begin(); fit != current_state.cdt.finite_faces_end(); ++fit)
+        // Οι καταστάσεις που δεν μπορούν να ξεπεράσουν τον incumbent δεν επεκτείνονται
+        if (context.pruned(current_state.obtuse_count, current_state.steiner_points))
+            continue;
+        // Εξερεύνηση όλων των τριγώνων με αμβλείες γωνίες: πρώτα συλλέγουμε τα υποψήφια σημεία, για κάθε τρίγωνο
+        // τις πιο υποσχόμενες στρατηγικές της κλάσης του μέχρι strategy_cutoff (τα σημεία εκτός περιοχής
+        // απορρίπτονται φθηνά και δεν μετράνε). Τα τρίγωνα διατρέχονται με τη σειρά Hilbert του mirror, οπότε και οι
+        // δοκιμαστικές εισαγωγές στο scratch ξεκινούν το locate κοντά στην προηγούμενη.
+        vector<Point> candidates;
+        vector<int> candidate_strategies;
+        vector<int> candidate_classes;
+        vector<Face_handle> candidate_faces;
+        // Γειτονικά τρίγωνα δίνουν συχνά το ίδιο σημείο (π.χ. το μέσο κοινής ακμής ή το κέντρο ενός cluster), οπότε
+        // κάθε διαφορετικό σημείο αξιολογείται μία φορά και οι επαναλήψεις του παίρνουν το ίδιο αποτέλεσμα
+        unordered_map<SnappedPoint, size_t, SnappedPointHash> candidate_index;
+        vector<pair<size_t, pair<int, int>>> duplicates; // (υποψήφιο, (κλάση, στρατηγική))
+        for (int32_t face : mesh.obtuse_faces())
         {
-            Point a = fit->vertex(0)->point();
-            Point b = fit->vertex(1)->point();
-            Point c = fit->vertex(2)->point();
-
-            if (CGAL::angle(a, b, c) == CGAL::OBTUSE || CGAL::angle(b, c, a) == CGAL::OBTUSE || CGAL::angle(c, a, b))
+            if (stop.should_stop())
+                return best_state;
+            Point a = mesh.point(face, 0);
+            Point b = mesh.point(face, 1);
+            Point c = mesh.point(face, 2);
+            int face_class = mesh.classify(face);
+            int selected = 0;
+            for (int strategy : context.selector.order(face_class))
             {
-                // Δοκιμή όλων των στρατηγικών
-                for (int strategy = 0; strategy < 5; ++strategy)
+                if (selected >= context.options.strategy_cutoff)
+                    break;
+                // Έλεγχος αν το σημείο είναι μέσα στο κυρτό περίβλημα
+                Point steiner;
+                if (propose_steiner_point(context, a, b, c, strategy, mesh, steiner))
                 {
-                    Point steiner = select_steiner_point(a, b, c, strategy, current_state.cdt, convex_hull);
-
-                    // Έλεγχος αν το σημείο είναι μέσα στο κυρτό περίβλημα
-                    if (convex_hull.bounded_side(steiner) == CGAL::ON_BOUNDED_SIDE || convex_hull.bounded_side(steiner) == CGAL::ON_BOUNDARY)
+                    auto inserted = candidate_index.insert(make_pair(snap_point(steiner), candidates.size()));
+                    selected++;
+                    if (!inserted.second)
                     {
-                        CDT temp_cdt = current_state.cdt;
-                        temp_cdt.insert(steiner);
-                        int new_obtuse = count_Obtuse_Angles(temp_cdt);
-
-                        // Δημιουργούμε μια νέα κατάσταση και ελέγχουμε αν υπάρχει ήδη
-                        State new_state = {temp_cdt, new_obtuse, current_state.steiner_points + 1, {}, {}};
-
-                        // Αν η νέα κατάσταση δεν έχει επισκεφθεί ξανά, την προσθέτουμε
-                        if (visited.find(new_state) == visited.end())
-                        {
-                            queue.push(new_state);
-                            visited.insert(new_state);
-                        }
+                        duplicates.push_back(make_pair(inserted.first->second, make_pair(face_class, strategy)));
+                        continue;
                     }
+                    candidates.push_back(steiner);
+                    candidate_strategies.push_back(strategy);
+                    candidate_classes.push_back(face_class);
+                    candidate_faces.push_back(mesh.handle(face));
                 }
+                else
+                {
+                    context.selector.update(face_class, strategy, false);
+                }
+            }
+        }
+
+        // Εκτός από το FULL_EVALUATION οι μεταβολές εκτιμώνται παράλληλα χωρίς αντίγραφα ολόκληρου του CDT
+        vector<int> predicted;
+        if (context.evaluation != FULL_EVALUATION)
+            predicted = estimate_insertion_deltas(context, current_state.cdt, candidate_faces, candidates);
+
+        // Οι δοκιμαστικές εισαγωγές γίνονται στο scratch και το cdt μιας νέας κατάστασης χτίζεται μόνο αν κρατηθεί
+        scratch.sync(current_state.cdt);
+        vector<char> improved(candidates.size(), false);
+        for (size_t k = 0; k < candidates.size(); ++k)
+        {
+            // Η επέκταση μιας κατάστασης είναι ακριβή, οπότε ελέγχουμε τη συνθήκη τερματισμού και εδώ
+            if (stop.should_stop())
+                return best_state;
+            if (context.evaluation != FULL_EVALUATION && predicted[k] == INT_MAX)
+            {
+                context.selector.update(candidate_classes[k], candidate_strategies[k], false);
+                continue;
+            }
+
+            int new_obtuse;
+            if (context.evaluation != FULL_EVALUATION)
+            {
+                // Η εκτίμηση επαληθεύεται μόνο αν η νέα κατάσταση θα γινόταν η καλύτερη
+                new_obtuse = current_state.obtuse_count + predicted[k];
+                if (new_obtuse < best_state.obtuse_count)
+                    new_obtuse = verify_candidate(scratch, current_state.obtuse_count, candidate_faces[k], candidates[k]);
+            }
+            else
+            {
+                STATS_COUNT(STAT_CANDIDATE_EVALUATIONS);
+                new_obtuse = verify_candidate(scratch, current_state.obtuse_count, candidate_faces[k], candidates[k]);
+            }
+            improved[k] = new_obtuse < current_state.obtuse_count;
+            context.selector.update(candidate_classes[k], candidate_strategies[k], improved[k]);
+            context.strategy_stats.evaluated(candidate_strategies[k], new_obtuse - current_state.obtuse_count);
+
+            // Δημιουργούμε μια νέα κατάσταση και ελέγχουμε αν υπάρχει ήδη (η σύγκριση δεν χρησιμοποιεί το cdt)
+            State new_state = {CDT(), new_obtuse, current_state.steiner_points + 1, {}, {}, current_state.operations};
+            new_state.operations.push_back(insert_operation(candidates[k], candidate_strategies[k], candidate_faces[k]));
+            bool better = new_obtuse < best_state.obtuse_count;
+            bool expand = visited.find(new_state) == visited.end() && !context.pruned(new_obtuse, new_state.steiner_points);
+            if (!better && !expand)
+                continue;
+            // Το visited κρατά την κατάσταση χωρίς cdt, αφού χρειάζεται μόνο για τη σύγκριση
+            if (expand)
+                visited.insert(new_state);
+            apply_candidate(current_state.cdt, candidates[k], new_state.cdt);
+
+            // Κρατάμε αμέσως τη νέα κατάσταση αν είναι καλύτερη, ώστε να μη χαθεί αν λήξει ο χρόνος
+            if (better)
+            {
+                best_state = new_state;
+                context.report(best_state);
+            }
+
+            // Αν η νέα κατάσταση δεν έχει επισκεφθεί ξανά, την προσθέτουμε
+            if (expand)
+            {
+                queue.push_back(move(new_state));
+                context.strategy_stats.accepted(candidate_strategies[k]);
             }
         }
+        for (const auto &duplicate : duplicates)
+        {
+            context.selector.update(duplicate.second.first, duplicate.second.second, improved[duplicate.first]);
+        }
         if (current_state.obtuse_count == best_state.obtuse_count)
         {
             iteration_count++;
@@ -302,44 +493,503 @@ State bfs_triangulation(CDT &initial_cdt, Polygon_2 &convex_hull, int &best_obtu
     return best_state;
 }
 
+// Πίνακας με τα διαθέσιμα engines αναζήτησης
+struct EngineEntry
+{
+    const char *name;
+    Engine run;
+    bool seeded; // το αποτέλεσμα εξαρτάται από το rng (αλλιώς δύο εκτελέσεις κάνουν την ίδια αναζήτηση)
+};
+
+static const EngineEntry engine_table[] = {
+    {"greedy", greedy_triangulation, false},
+    {"bfs", bfs_triangulation, false},
+    {"annealing", annealing_triangulation, true},
+    {"restarts", restarts_triangulation, true},
+};
+
+Engine find_engine(const string &name)
+{
+    for (const EngineEntry &entry : engine_table)
+    {
+        if (name == entry.name)
+            return entry.run;
+    }
+    throw invalid_argument("Unknown engine '" + name + "'.");
+}
+
+// Σειρά κατάταξης των λύσεων: πρώτα τα αμβλυγώνια και μετά τα Steiner points
+bool is_better_state(const State &a, const State &b)
+{
+    return a.obtuse_count < b.obtuse_count || (a.obtuse_count == b.obtuse_count && a.steiner_points < b.steiner_points);
+}
+
+// Τα μηνύματα προόδου πάνε στο SolverOptions::log. Χωρίς log γράφονται σε ένα stream χωρίς buffer, που τα
+// απορρίπτει (ένα ανά νήμα, γιατί η απόρριψη αλλάζει την κατάσταση του stream).
+ostream &progress_log(ostream *log)
+{
+    thread_local ostream discard(nullptr);
+    return log ? *log : discard;
+}
+
+// Portfolio: κάθε νήμα τρέχει ένα engine (με δικό του CDT και seed) πάνω στο ίδιο instance. Τα engines που δεν
+// εξαρτώνται από το rng (greedy, bfs) τρέχουν μία φορά και τα υπόλοιπα νήματα μοιράζονται στα τυχαιοποιημένα.
+// Όλα μοιράζονται τον incumbent του context, ώστε τα πιο αδύναμα να κλαδεύουν και να σταματούν νωρίτερα.
+State portfolio_triangulation(const State &initial_state, SearchContext &context, unsigned threads)
+{
+    const size_t engine_count = sizeof(engine_table) / sizeof(engine_table[0]);
+    if (threads == 0)
+        threads = max(thread::hardware_concurrency(), (unsigned)engine_count);
+
+    vector<const EngineEntry *> assigned, seeded;
+    for (const EngineEntry &entry : engine_table)
+    {
+        if (entry.seeded)
+            seeded.push_back(&entry);
+        else
+            assigned.push_back(&entry);
+    }
+    // Με λιγότερα νήματα από engines κρατάμε ένα από κάθε είδος: πρώτα τα ντετερμινιστικά, μετά τα τυχαιοποιημένα
+    for (size_t i = 0; i < seeded.size() && assigned.size() < threads; ++i)
+        assigned.push_back(seeded[i]);
+    if (assigned.size() > threads)
+        assigned.resize(threads);
+    for (size_t i = 0; assigned.size() < threads; ++i)
+        assigned.push_back(seeded[i % seeded.size()]);
+
+    vector<State> results(threads, initial_state);
+    vector<exception_ptr> errors(threads);
+    vector<thread> workers;
+    for (unsigned i = 0; i < threads; ++i)
+    {
+        workers.emplace_back([&, i]()
+                             {
+            try
+            {
+                mt19937 rng(context.options.seed + i);
+                results[i] = assigned[i]->run(initial_state, context, rng);
+            }
+            catch (...)
+            {
+                errors[i] = current_exception();
+            } });
+    }
+    for (thread &worker : workers)
+    {
+        worker.join();
+    }
+    for (const exception_ptr &error : errors)
+    {
+        if (error)
+            rethrow_exception(error);
+    }
+
+    size_t best = 0;
+    for (size_t i = 1; i < results.size(); ++i)
+    {
+        if (is_better_state(results[i], results[best]))
+            best = i;
+    }
+    progress_log(context.options.log) << "Best solution found by engine '" << assigned[best]->name << "'" << endl;
+    return results[best];
+}
+
+// Instance που δείχνει στα δεδομένα των vectors. Συντεταγμένες διαφορετικού μήκους απορρίπτονται.
+static Instance view_instance(const vector<int> &points_x, const vector<int> &points_y, const vector<int> &region_boundary, const vector<pair<int, int>> &additional_constraints)
+{
+    if (points_x.size() != points_y.size())
+        throw invalid_argument("The point coordinates differ in length (" + to_string(points_x.size()) + " x, " + to_string(points_y.size()) + " y).");
+    Instance instance = {points_x.data(), points_y.data(), points_x.size(), region_boundary.data(), region_boundary.size(),
+                         additional_constraints.data(), additional_constraints.size()};
+    return instance;
+}
+
+// Έλεγχος των δεικτών του instance, ώστε δεδομένα από τον καλούντα να μην οδηγούν σε πρόσβαση εκτός ορίων
+static void validate_instance(const Instance &instance)
+{
+    if (instance.boundary_size < 3)
+        throw invalid_argument("The region boundary needs at least 3 points.");
+    auto valid = [&](int i)
+    {
+        return i >= 0 && (size_t)i < instance.point_count;
+    };
+    for (size_t i = 0; i < instance.boundary_size; ++i)
+    {
+        if (!valid(instance.region_boundary[i]))
+            throw invalid_argument("Invalid region boundary index " + to_string(instance.region_boundary[i]) + ".");
+    }
+    for (size_t i = 0; i < instance.constraint_count; ++i)
+    {
+        if (!valid(instance.constraints[i].first) || !valid(instance.constraints[i].second))
+            throw invalid_argument("Invalid constraint " + to_string(instance.constraints[i].first) + "-" + to_string(instance.constraints[i].second) + ".");
+    }
+}
+
+// Property map από δείκτη σημείου στο Point του instance, για τη χωρική ταξινόμηση δεικτών
+struct InstancePointMap
+{
+    typedef size_t key_type;
+    typedef Point value_type;
+    typedef Point reference;
+    typedef boost::readable_property_map_tag category;
+
+    const InstancePoints *points;
+
+    friend Point get(const InstancePointMap &map, size_t i)
+    {
+        return (*map.points)[i];
+    }
+};
+
+// Το πολύγωνο της περιοχής και το αρχικό CDT με τα constraints ενός instance, διαβάζοντας τα σημεία απευθείας
+// από τους πίνακες του καλούντος
+static void build_instance(const Instance &instance, const InstancePoints &points, Polygon_2 &convex_hull, CDT &cdt)
+{
+    validate_instance(instance);
+    for (size_t i = 0; i < instance.boundary_size; ++i)
+    {
+        convex_hull.push_back(points[instance.region_boundary[i]]);
+    }
+
+    // Όλα τα σημεία του instance (και τα εσωτερικά, όχι μόνο τα άκρα των constraints) εισάγονται μία φορά, σε
+    // χωρική σειρά και με hint την προηγούμενη κορυφή, ώστε κάθε locate να είναι σύντομο. Τα constraints μπαίνουν
+    // μετά με τα vertex handles, χωρίς νέο locate.
+    STATS_TIMER(STAT_TIMER_CDT_BUILD);
+    vector<size_t> order(instance.point_count);
+    for (size_t i = 0; i < instance.point_count; ++i)
+    {
+        order[i] = i;
+    }
+    InstancePointMap point_map = {&points};
+    CGAL::spatial_sort(order.begin(), order.end(), CGAL::Spatial_sort_traits_adapter_2<K, InstancePointMap>(point_map));
+
+    vector<Vertex_handle> vertices(instance.point_count);
+    Vertex_handle hint;
+    for (size_t i : order)
+    {
+        hint = hint == Vertex_handle() ? cdt.insert(points[i]) : cdt.insert(points[i], hint->face());
+        vertices[i] = hint;
+    }
+    for (size_t i = 0; i < instance.boundary_size; ++i)
+    {
+        size_t next = (i + 1) % instance.boundary_size;
+        cdt.insert_constraint(vertices[instance.region_boundary[i]], vertices[instance.region_boundary[next]]);
+    }
+    for (size_t i = 0; i < instance.constraint_count; ++i)
+    {
+        cdt.insert_constraint(vertices[instance.constraints[i].first], vertices[instance.constraints[i].second]);
+    }
+}
+
+// Εισαγωγή των Steiner points μιας προηγούμενης λύσης (warm start). Παραλείπονται όσα είναι εκτός περιοχής ή
+// συμπίπτουν με σημεία του instance. Οι εισαγωγές καταγράφονται στο operations με τη σειρά που εκτελούνται, ώστε
+// το replay ενός checkpoint να ξαναχτίζει ακριβώς την ίδια τριγωνοποίηση.
+static int warm_start(CDT &cdt, const InstancePoints &points, const Polygon_2 &region, const vector<double> &steiner_x, const vector<double> &steiner_y,
+                      vector<Operation> &operations)
+{
+    set<Point> existing(points.begin(), points.end());
+    vector<Point> steiner;
+    for (size_t i = 0; i < steiner_x.size() && i < steiner_y.size(); ++i)
+    {
+        Point p(steiner_x[i], steiner_y[i]);
+        if (region.bounded_side(p) != CGAL::ON_UNBOUNDED_SIDE && existing.insert(p).second)
+            steiner.push_back(p);
+    }
+    // Χωρική ταξινόμηση και εισαγωγή ένα-ένα με hint την προηγούμενη κορυφή, ώστε κάθε locate να ξεκινά κοντά
+    CGAL::spatial_sort(steiner.begin(), steiner.end());
+    Vertex_handle hint;
+    for (const Point &p : steiner)
+    {
+        hint = hint == Vertex_handle() ? cdt.insert(p) : cdt.insert(p, hint->face());
+        operations.push_back(insert_operation(p));
+    }
+    return steiner.size();
+}
+
+Solution triangulate(const vector<int> &points_x, const vector<int> &points_y, const vector<int> &region_boundary, const vector<pair<int, int>> &additional_constraints, const SolverOptions &options)
+{
+    return triangulate(view_instance(points_x, points_y, region_boundary, additional_constraints), options);
+}
+
 // Κύρια συνάρτηση
-void triangulate(vector<int> &points_x, vector<int> &points_y, vector<int> &region_boundary, vector<pair<int, int>> &additional_constraints)
+static Solution solve(const Instance &instance, const SolverOptions &options)
 {
+    auto start_time = chrono::steady_clock::now();
+    StopCondition stop(options.time_limit_ms, options.cancel_flag);
+    unique_ptr<ConvergenceTrace> trace;
+    if (!options.trace_file.empty())
+    {
+        trace.reset(new ConvergenceTrace(options.trace_file, options.trace_interval_ms));
+        if (!trace->is_open())
+        {
+            cerr << "Warning: could not open the trace file '" << options.trace_file << "'." << endl;
+            trace.reset();
+        }
+    }
     CDT cdt;
-    vector<Point> points;
+    InstancePoints points(instance.points_x, instance.points_y, instance.point_count);
+    Polygon_2 convex_hull;
+    build_instance(instance, points, convex_hull, cdt);
+    // Οι αλλαγές πριν από την αναζήτηση για το operation log (οι επόμενες καταγράφονται στο State)
+    vector<Operation> setup_operations;
+    bool resuming = !options.resume_file.empty();
+    Checkpoint resume_checkpoint;
+    if (resuming)
+    {
+        resume_checkpoint = read_checkpoint(options.resume_file);
+        if (resume_checkpoint.engine != options.engine)
+            throw invalid_argument("The checkpoint '" + options.resume_file + "' was written by the " + resume_checkpoint.engine + " engine, not " + options.engine + ".");
+        if (resume_checkpoint.instance != instance_fingerprint(instance))
+            throw invalid_argument("The checkpoint '" + options.resume_file + "' was written for a different instance.");
+        progress_log(options.log) << "Resuming from the checkpoint '" << options.resume_file << "'" << endl;
+        if (!options.warm_start_x.empty())
+            cerr << "Warning: the warm start points are already in the checkpoint, ignoring them." << endl;
+    }
+    else if (!options.warm_start_x.empty())
+    {
+        int inserted = warm_start(cdt, points, convex_hull, options.warm_start_x, options.warm_start_y, setup_operations);
+        progress_log(options.log) << "Warm start: " << inserted << " of " << options.warm_start_x.size() << " Steiner points inserted" << endl;
+    }
 
-    for (size_t i = 0; i < points_x.size(); ++i)
+    int initial_obtuse;
+    {
+        STATS_TIMER(STAT_TIMER_INITIAL_COUNT);
+        initial_obtuse = count_Obtuse_Angles(cdt);
+    }
+    progress_log(options.log) << "Initial obtuse angles: " << initial_obtuse << endl;
+    int initial_obtuse_count = initial_obtuse;
+    // Τα flips δεν προσθέτουν Steiner points, οπότε γίνονται πριν από κάθε engine. Στη συνέχιση εφαρμόζονται
+    // οι αλλαγές (warm start και flips) που έγιναν στην αρχική εκτέλεση.
+    if (resuming)
     {
-        points.push_back(Point(points_x[i], points_y[i]));
+        for (const Operation &operation : resume_checkpoint.setup)
+        {
+            if (!apply_operation(cdt, operation))
+                throw invalid_argument("The checkpoint operation '" + format_operation(operation) + "' could not be applied.");
+        }
+        setup_operations = resume_checkpoint.setup;
+        initial_obtuse = count_Obtuse_Angles(cdt);
+    }
+    else if (options.flip_edges)
+    {
+        STATS_TIMER(STAT_TIMER_EDGE_FLIPS);
+        int flips = flip_optimization(cdt, &setup_operations);
+        progress_log(options.log) << "Edge flips before the search: " << flips << endl;
+        initial_obtuse = count_Obtuse_Angles(cdt);
+    }
+    // Τα Steiner points του warm start μετράνε στην αρχική κατάσταση, ώστε να μπορούν να αφαιρεθούν στο τέλος
+    State initial_state = {cdt, initial_obtuse, 0, {}, {}};
+    for (const Operation &operation : setup_operations)
+    {
+        if (operation.type == Operation::INSERT)
+        {
+            initial_state.steiner_points++;
+            initial_state.steiner_locations.push_back(operation.p);
+            initial_state.strategies.push_back(operation.strategy);
+        }
+    }
+    if (options.flip_edges)
+    {
+        progress_log(options.log) << "Obtuse angles after the edge flips: " << initial_state.obtuse_count << endl;
     }
 
-    Polygon_2 convex_hull;
-    for (size_t i : region_boundary)
+    // Κάθε βελτίωση γράφεται αμέσως στην έξοδο μέσω του on_improvement. Στο portfolio πολλά νήματα μπορεί να
+    // αναφέρουν ταυτόχρονα, οπότε γράφουμε μόνο αν η λύση είναι ακόμη ο incumbent. Η λύση χτίζεται από το νήμα που
+    // τη βρήκε, υπό το report_mutex γίνεται μόνο η πιο πρόσφατη (pending), και τη γράφει όποιο νήμα κρατά το
+    // write_mutex. Έτσι τα engines δεν περιμένουν το I/O των άλλων: αν γράφει ήδη κάποιο νήμα, γράφει και αυτή.
+    Incumbent incumbent;
+    mutex report_mutex, write_mutex;
+    Solution pending;
+    long long published = 0, written = 0;
+    auto on_improvement = [&](const State &state)
+    {
+        if (!options.on_improvement || !incumbent.holds(state.obtuse_count, state.steiner_points))
+            return;
+        Solution solution = build_solution(state.cdt, points, convex_hull, state.obtuse_count);
+        {
+            lock_guard<mutex> lock(report_mutex);
+            if (!incumbent.holds(state.obtuse_count, state.steiner_points))
+                return;
+            pending = move(solution);
+            published++;
+        }
+        for (;;)
+        {
+            if (!write_mutex.try_lock())
+                return;
+            Solution snapshot;
+            bool fresh;
+            {
+                lock_guard<mutex> lock(report_mutex);
+                fresh = written < published;
+                if (fresh)
+                {
+                    snapshot = pending;
+                    written = published;
+                }
+            }
+            if (fresh)
+                options.on_improvement(snapshot);
+            write_mutex.unlock();
+            // Μια λύση που δημοσιεύτηκε όσο γράφαμε δεν θα τη γράψει κανείς άλλος
+            lock_guard<mutex> lock(report_mutex);
+            if (written == published)
+                return;
+        }
+    };
+    bool portfolio = options.engine == "portfolio";
+    StrategySelector selector;
+    StrategyStatistics strategy_stats;
+    EvaluationMode evaluation = parse_evaluation_mode(options.evaluation);
+    // Στο portfolio τα νήματα είναι ήδη απασχολημένα από τα engines
+    WorkerPool workers(portfolio ? 1 : (options.threads > 0 ? options.threads : max(thread::hardware_concurrency(), 1u)));
+    // Στο portfolio η κατάσταση είναι μοιρασμένη σε πολλά νήματα, οπότε δεν υποστηρίζει checkpoints (και ένα
+    // checkpoint δεν έχει ποτέ engine "portfolio", άρα ούτε συνέχιση)
+    unique_ptr<Checkpointer> checkpointer;
+    if (!options.checkpoint_file.empty())
     {
-        convex_hull.push_back(points[i]);
+        if (portfolio)
+            cerr << "Warning: the portfolio engine does not support checkpoints." << endl;
+        else
+            checkpointer.reset(new Checkpointer(options.checkpoint_file, options.checkpoint_interval_ms, options.engine, instance_fingerprint(instance), setup_operations, options.log));
     }
+    if (resuming)
+        selector.restore(resume_checkpoint.selector_attempts, resume_checkpoint.selector_successes);
+    SearchContext context = {convex_hull, options, stop, incumbent, selector, strategy_stats, trace.get(), checkpointer.get(),
+                             resuming ? &resume_checkpoint : nullptr, evaluation, workers, portfolio, on_improvement};
 
-    // Προσθήκη constraints
-    for (size_t i = 0; i < region_boundary.size(); ++i)
+    State best = initial_state;
     {
-        int next = (i + 1) % region_boundary.size();
-        cdt.insert_constraint(points[region_boundary[i]], points[region_boundary[next]]);
+        STATS_TIMER(STAT_TIMER_SEARCH);
+        if (portfolio)
+        {
+            best = portfolio_triangulation(initial_state, context, options.threads);
+        }
+        else
+        {
+            mt19937 rng(options.seed);
+            best = find_engine(options.engine)(initial_state, context, rng);
+        }
     }
-    for (const auto &constraint : additional_constraints)
+
+    // Τελικά περάσματα: μετακίνηση των Steiner points στο star τους και αφαίρεση όσων έγιναν περιττά. Μετράνε στο
+    // χρονικό όριο όπως η αναζήτηση, οπότε γίνονται μόνο αν έχει μείνει χρόνος.
     {
-        cdt.insert_constraint(points[constraint.first], points[constraint.second]);
+        STATS_TIMER(STAT_TIMER_POST_PROCESSING);
+        if (options.relocate_steiner && best.steiner_points > 0 && !stop.should_stop())
+        {
+            vector<pair<Point, Point>> moves = steiner_relocation(best.cdt, points, stop);
+            for (const auto &move : moves)
+            {
+                replace(best.steiner_locations.begin(), best.steiner_locations.end(), move.first, move.second);
+                best.operations.push_back(move_operation(move.first, move.second));
+            }
+            // Μετά τις μετακινήσεις μπορεί να υπάρχουν νέα flips που μειώνουν τα αμβλυγώνια
+            if (options.flip_edges)
+            {
+                flip_optimization(best.cdt, &best.operations);
+            }
+            best.obtuse_count = count_Obtuse_Angles(best.cdt);
+            progress_log(options.log) << "Steiner point relocations: " << moves.size() << ", obtuse angles: " << best.obtuse_count << endl;
+            context.report(best);
+        }
+        if (options.remove_steiner && best.steiner_points > 0 && !stop.should_stop())
+        {
+            vector<Point> removed = steiner_removal(best.cdt, points, options.threads, stop, &best.operations);
+            for (const Point &p : removed)
+            {
+                for (size_t i = 0; i < best.steiner_locations.size(); ++i)
+                {
+                    if (best.steiner_locations[i] == p)
+                    {
+                        best.steiner_locations.erase(best.steiner_locations.begin() + i);
+                        best.strategies.erase(best.strategies.begin() + i);
+                        break;
+                    }
+                }
+            }
+            best.steiner_points -= removed.size();
+            best.obtuse_count = count_Obtuse_Angles(best.cdt);
+            progress_log(options.log) << "Redundant Steiner points removed: " << removed.size() << endl;
+            context.report(best);
+        }
     }
 
-    int best_obtuse = count_Obtuse_Angles(cdt);
-    cout << "Initial obtuse angles: " << best_obtuse << endl;
-    CDT best_cdt;
-    int max_depth = 1000;
-    int max_iterations = 100;
+    if (trace)
+        trace->finish(incumbent);
+    if (!options.operation_log.empty())
+    {
+        vector<Operation> operations = setup_operations;
+        operations.insert(operations.end(), best.operations.begin(), best.operations.end());
+        if (write_operation_log(options.operation_log, operations))
+            progress_log(options.log) << "Operation log (" << operations.size() << " operations) written to '" << options.operation_log << "'" << endl;
+        else
+            cerr << "Warning: could not write the operation log '" << options.operation_log << "'." << endl;
+    }
 
-    State best = bfs_triangulation(cdt, convex_hull, best_obtuse, best_cdt, max_depth, max_iterations);
-    cout << "Final obtuse angles: " << best.obtuse_count << endl;
-    cout << "Number of Steiner points added:" << best.steiner_points << endl;
-    CGAL::draw(best.cdt);
+    if (stop.cancelled())
+    {
+        progress_log(options.log) << "Search cancelled, keeping the best solution found" << endl;
+    }
+    else if (stop.timed_out())
+    {
+        progress_log(options.log) << "Time limit of " << options.time_limit_ms << " ms reached, keeping the best solution found" << endl;
+    }
+    progress_log(options.log) << "Final obtuse angles: " << best.obtuse_count << endl;
+    progress_log(options.log) << "Number of Steiner points added:" << best.steiner_points << endl;
+    vector<StrategyReport> strategy_reports = strategy_stats.report();
+    for (const StrategyReport &report : strategy_reports)
+    {
+        progress_log(options.log) << "Strategy " << report.strategy << ": " << report.attempts << " attempts, " << report.out_of_domain << " out of domain, "
+             << report.evaluated << " evaluated (average delta " << report.average_delta << "), " << report.accepted << " accepted, "
+             << report.time_ms << " ms" << endl;
+    }
+    if (options.draw && !stop.cancelled())
+    {
+        CGAL::draw(best.cdt);
+    }
+    Solution solution = build_solution(best.cdt, points, convex_hull, best.obtuse_count);
+    solution.strategy_reports = strategy_reports;
+    solution.initial_obtuse_count = initial_obtuse_count;
+    solution.time_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start_time).count();
+    solution.timed_out = stop.timed_out();
+    solution.cancelled = stop.cancelled();
+    return solution;
+}
+
+Solution triangulate(const Instance &instance, const SolverOptions &options)
+{
+    Solution solution = solve(instance, options);
+    // Όλα τα CDT της εκτέλεσης έχουν πλέον καταστραφεί, οπότε η μνήμη που κρατά η arena του νήματος επιστρέφει στο heap
+    ArenaPool::release();
+    return solution;
+}
+
+Solution replay(const vector<int> &points_x, const vector<int> &points_y, const vector<int> &region_boundary, const vector<pair<int, int>> &additional_constraints, const string &operation_log, ostream *log)
+{
+    return replay(view_instance(points_x, points_y, region_boundary, additional_constraints), operation_log, log);
+}
+
+// Αναπαραγωγή μιας λύσης από το instance και το operation log της, χωρίς αναζήτηση
+Solution replay(const Instance &instance, const string &operation_log, ostream *log)
+{
+    vector<Operation> operations = read_operation_log(operation_log);
+    CDT cdt;
+    InstancePoints points(instance.points_x, instance.points_y, instance.point_count);
+    Polygon_2 convex_hull;
+    build_instance(instance, points, convex_hull, cdt);
+
+    int skipped = 0;
+    for (const Operation &operation : operations)
+    {
+        if (!apply_operation(cdt, operation))
+            skipped++;
+    }
+    int obtuse_count = count_Obtuse_Angles(cdt);
+    progress_log(log) << "Replayed " << operations.size() - skipped << " of " << operations.size() << " operations, obtuse angles: " << obtuse_count << endl;
+    if (skipped > 0)
+        cerr << "Warning: " << skipped << " operations could not be applied, the result may differ from the original run." << endl;
+    return build_solution(cdt, points, convex_hull, obtuse_count);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -3,9 +3,125 @@
 
 #include <vector>
 #include <utility>
+#include <functional>
+#include <atomic>
+#include <string>
+#include <cstddef>
+#include <ostream>
 using namespace std;
 
-// Δήλωση της συνάρτησης τριγωνοποίησης
-void triangulate(const vector<int> &points_x, const vector<int> &points_y, const vector<int> &region_boundary, const vector<pair<int, int>> &additional_constraints);
+// Δημόσιο API της βιβλιοθήκης libtriangulation
 
-#endif // TRIANGULATION_H
\ No newline at end of file
+// Instance στη μνήμη του καλούντος, χωρίς αντίγραφο: οι συντεταγμένες ως δύο πίνακες point_count στοιχείων,
+// το region_boundary ως δείκτες σημείων (σε σειρά πάνω στο σύνορο) και τα constraints ως ζεύγη δεικτών.
+// Οι πίνακες πρέπει να ζουν μέχρι να επιστρέψει το triangulate.
+struct Instance
+{
+    const int *points_x;
+    const int *points_y;
+    size_t point_count;
+    const int *region_boundary;
+    size_t boundary_size;
+    const pair<int, int> *constraints;
+    size_t constraint_count;
+};
+
+// Στατιστικά μιας στρατηγικής του select_steiner_point σε μία εκτέλεση
+struct StrategyReport
+{
+    int strategy;
+    long long attempts;      // σημεία που υπολογίστηκαν
+    long long out_of_domain; // σημεία εκτός περιοχής που απορρίφθηκαν
+    long long evaluated;     // σημεία που αξιολογήθηκαν
+    double average_delta;    // μέση μεταβολή των αμβλυγώνιων στα σημεία που αξιολογήθηκαν
+    long long accepted;      // σημεία που έγιναν δεκτά από το engine
+    double time_ms;          // συνολικός χρόνος υπολογισμού των σημείων
+};
+
+// Λύση σε μορφή CG:SHOP 2025 (τα edges αναφέρονται στα αρχικά σημεία και μετά στα Steiner points)
+struct Solution
+{
+    vector<double> steiner_points_x;
+    vector<double> steiner_points_y;
+    vector<pair<int, int>> edges;
+    int obtuse_count = 0;
+    int steiner_points = 0;
+    vector<StrategyReport> strategy_reports; // μόνο στην τελική λύση του triangulate
+
+    // Στατιστικά της εκτέλεσης (μόνο στην τελική λύση του triangulate)
+    int initial_obtuse_count = 0; // αμβλυγώνια του αρχικού CDT
+    double time_ms = 0;           // συνολικός χρόνος του triangulate
+    bool timed_out = false;       // η αναζήτηση σταμάτησε στο time_limit_ms
+    bool cancelled = false;       // η αναζήτηση σταμάτησε από το cancel_flag
+};
+
+// Παράμετροι της αναζήτησης
+struct SolverOptions
+{
+    int max_depth = 1000;        // μέγιστο πλήθος Steiner points σε μία κατάσταση
+    int max_iterations = 100;    // επαναλήψεις χωρίς βελτίωση πριν σταματήσει η αναζήτηση
+    long long time_limit_ms = 0; // χρονικό όριο ανά instance σε ms (0 = χωρίς όριο)
+    bool draw = false;           // εμφάνιση της τελικής τριγωνοποίησης (ανοίγει παράθυρο Qt)
+    bool flip_edges = true;      // flips ακμών που μειώνουν τα αμβλυγώνια πριν ξεκινήσει η αναζήτηση
+    bool relocate_steiner = true; // μετακίνηση των Steiner points μέσα στο star τους μετά την αναζήτηση
+    bool remove_steiner = true;  // αφαίρεση περιττών Steiner points μετά την αναζήτηση
+
+    // Engine αναζήτησης: "bfs", "greedy", "annealing", "restarts" ή "portfolio" (όλα παράλληλα σε νήματα)
+    string engine = "bfs";
+    unsigned threads = 0;  // νήματα του portfolio και των παράλληλων περασμάτων (0 = όσα υποστηρίζει το μηχάνημα)
+    unsigned seed = 0;     // seed για τα τυχαιοποιημένα engines
+    int restarts = 10;     // επανεκκινήσεις του engine "restarts"
+
+    // Πόσες στρατηγικές δοκιμάζονται ανά αμβλυγώνιο τρίγωνο, με τη σειρά που προτείνει ο StrategySelector (1-5).
+    // Η προεπιλογή δοκιμάζει όλες, όπως πριν από τον selector. Μικρότερες τιμές ανταλλάσσουν ποιότητα με ταχύτητα.
+    int strategy_cutoff = 5;
+
+    // Αξιολόγηση υποψήφιων σημείων: "full" (εισαγωγή σε αντίγραφο του CDT και καταμέτρηση),
+    // "predict" (πρόβλεψη από τη ζώνη σύγκρουσης χωρίς αλλαγή του CDT) ή "submesh" (εισαγωγή σε μικρό CDT
+    // με τα τρίγωνα σε απόσταση submesh_rings). Στα δύο τελευταία επαληθεύεται μόνο το σημείο που επιλέγεται.
+    string evaluation = "full";
+    int submesh_rings = 2;
+
+    // Αν οριστεί, γράφεται εκεί η χρονοσειρά σύγκλισης (CSV, ή JSON lines αν τελειώνει σε .jsonl),
+    // με ένα δείγμα το πολύ κάθε trace_interval_ms και σε κάθε βελτίωση. Η στήλη frontier_size είναι στο bfs το
+    // μέγεθος της ουράς και στα άλλα engines τα αμβλυγώνια τρίγωνα της τρέχουσας κατάστασης.
+    string trace_file;
+    long long trace_interval_ms = 100;
+
+    // Αν οριστεί, γράφονται εκεί όλες οι αλλαγές (εισαγωγές, flips, μετακινήσεις, αφαιρέσεις) που οδήγησαν στην
+    // τελική λύση, ώστε το replay να την ξαναχτίσει χωρίς αναζήτηση
+    string operation_log;
+
+    // Αν οριστεί, η κατάσταση της αναζήτησης γράφεται εκεί κάθε checkpoint_interval_ms, ώστε μια διακοπείσα
+    // εκτέλεση να συνεχίσει με resume_file (το ίδιο instance και engine). Δεν υποστηρίζεται από το portfolio.
+    string checkpoint_file;
+    long long checkpoint_interval_ms = 60000;
+    string resume_file;
+
+    // Steiner points μιας προηγούμενης λύσης, που εισάγονται πριν από την αναζήτηση (warm start). Η αναζήτηση
+    // συνεχίζει από αυτή τη λύση αντί από το σκέτο CDT.
+    vector<double> warm_start_x;
+    vector<double> warm_start_y;
+
+    // Αν οριστεί, η αναζήτηση σταματά μόλις γίνει true και επιστρέφεται η καλύτερη λύση μέχρι τότε
+    const atomic<bool> *cancel_flag = nullptr;
+
+    // Καλείται κάθε φορά που βελτιώνεται η καλύτερη λύση (anytime έξοδος)
+    function<void(const Solution &)> on_improvement;
+
+    // Αν οριστεί, εκεί γράφονται τα μηνύματα προόδου (αρχικά/τελικά αμβλυγώνια, στατιστικά στρατηγικών κ.λπ.).
+    // Από προεπιλογή η βιβλιοθήκη δεν γράφει τίποτα στο cout. Οι προειδοποιήσεις πάνε πάντα στο cerr.
+    ostream *log = nullptr;
+};
+
+// Δήλωση της συνάρτησης τριγωνοποίησης, επιστρέφει την καλύτερη λύση που βρέθηκε.
+// Πετάει invalid_argument αν το instance ή οι παράμετροι δεν είναι έγκυρα.
+Solution triangulate(const Instance &instance, const SolverOptions &options);
+Solution triangulate(const vector<int> &points_x, const vector<int> &points_y, const vector<int> &region_boundary, const vector<pair<int, int>> &additional_constraints, const SolverOptions &options);
+
+// Ξαναχτίζει τη λύση ενός instance από το operation log μιας προηγούμενης εκτέλεσης (SolverOptions::operation_log).
+// Πετάει invalid_argument αν το log δεν διαβάζεται. Το log είναι όπως στο SolverOptions::log.
+Solution replay(const Instance &instance, const string &operation_log, ostream *log = nullptr);
+Solution replay(const vector<int> &points_x, const vector<int> &points_y, const vector<int> &region_boundary, const vector<pair<int, int>> &additional_constraints, const string &operation_log, ostream *log = nullptr);
+
+#endif // TRIANGULATION_H
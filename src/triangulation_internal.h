@@ -0,0 +1,638 @@
+#ifndef TRIANGULATION_INTERNAL_H
+#define TRIANGULATION_INTERNAL_H
+
+#include "arena_allocator.h" // πριν από τα headers της CGAL (CGAL_ALLOCATOR)
+#include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
+#include <CGAL/Constrained_Delaunay_triangulation_2.h>
+#include <CGAL/Triangulation_vertex_base_with_info_2.h>
+#include <CGAL/Triangulation_face_base_with_info_2.h>
+#include <CGAL/Polygon_2.h>
+#include "triangulation.h"
+#include "stats.h"
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <cstdint>
+#include <set>
+#include <fstream>
+#include <iterator>
+#include <cstddef>
+
+// Κοινοί τύποι και συναρτήσεις για τα αρχεία της τριγωνοποίησης (δεν είναι μέρος του δημόσιου API)
+
+//////////////////////////////////////////////////////////
+
+// Η θέση μιας κορυφής ή ενός τριγώνου στο MeshMirror (το info των handles), -1 αν δεν έχει αριθμηθεί
+struct MeshIndex
+{
+    int32_t index;
+    MeshIndex() : index(-1) {}
+};
+
+// kernel
+typedef CGAL::Exact_predicates_inexact_constructions_kernel K;
+typedef CGAL::Simple_cartesian<double> Kernel;
+typedef CGAL::Triangulation_vertex_base_with_info_2<MeshIndex, K> Vb;
+typedef CGAL::Triangulation_face_base_with_info_2<MeshIndex, K> Fbb;
+typedef CGAL::Constrained_triangulation_face_base_2<K, Fbb> Fb;
+typedef CGAL::Triangulation_data_structure_2<Vb, Fb> Tds;
+typedef CGAL::Exact_predicates_tag Itag;
+typedef CGAL::Constrained_Delaunay_triangulation_2<K, Tds, Itag> CDT;
+typedef K::Line_2 Line;
+typedef CDT::Point Point;
+typedef CGAL::Polygon_2<K> Polygon_2;
+typedef CDT::Face_handle Face_handle;
+typedef CDT::Vertex_handle Vertex_handle;
+using namespace std;
+
+///////////////////////////////////////////////////
+
+// Συνθήκη τερματισμού της αναζήτησης: χρονικό όριο (wall-clock) ή αίτημα ακύρωσης (π.χ. από SIGINT/SIGTERM)
+class StopCondition
+{
+public:
+    StopCondition(long long time_limit_ms, const atomic<bool> *cancel_flag)
+        : enabled(time_limit_ms > 0),
+          end(chrono::steady_clock::now() + chrono::milliseconds(time_limit_ms)),
+          cancel_flag(cancel_flag) {}
+
+    bool timed_out() const
+    {
+        return enabled && chrono::steady_clock::now() >= end;
+    }
+
+    bool cancelled() const
+    {
+        return cancel_flag != nullptr && cancel_flag->load();
+    }
+
+    bool should_stop() const
+    {
+        return cancelled() || timed_out();
+    }
+
+private:
+    bool enabled;
+    chrono::steady_clock::time_point end;
+    const atomic<bool> *cancel_flag;
+};
+
+// Τα σημεία ενός instance απευθείας από τους πίνακες x/y του καλούντος (SoA), χωρίς αντίγραφο. Κάθε Point
+// κατασκευάζεται τη στιγμή της ανάγνωσης, οπότε οι πίνακες πρέπει να ζουν όσο και το InstancePoints.
+class InstancePoints
+{
+public:
+    InstancePoints(const int *x, const int *y, size_t count) : x(x), y(y), count(count) {}
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    Point operator[](size_t i) const
+    {
+        return Point(x[i], y[i]);
+    }
+
+    class const_iterator
+    {
+    public:
+        typedef forward_iterator_tag iterator_category;
+        typedef Point value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const Point *pointer;
+        typedef Point reference;
+
+        const_iterator(const InstancePoints *points, size_t i) : points(points), i(i) {}
+        Point operator*() const
+        {
+            return (*points)[i];
+        }
+        const_iterator &operator++()
+        {
+            ++i;
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            const_iterator old = *this;
+            ++i;
+            return old;
+        }
+        bool operator==(const const_iterator &other) const
+        {
+            return i == other.i;
+        }
+        bool operator!=(const const_iterator &other) const
+        {
+            return i != other.i;
+        }
+
+    private:
+        const InstancePoints *points;
+        size_t i;
+    };
+
+    const_iterator begin() const
+    {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(this, count);
+    }
+
+private:
+    const int *x;
+    const int *y;
+    size_t count;
+};
+
+// State definition
+// Μία αλλαγή της τριγωνοποίησης στο operation log, από το οποίο το replay ξαναχτίζει την τελική λύση
+// χωρίς αναζήτηση (operation_log.cpp)
+struct Operation
+{
+    enum Type
+    {
+        INSERT,
+        FLIP,
+        MOVE,
+        REMOVE
+    };
+    Type type;
+    Point p;       // INSERT/REMOVE: το σημείο, FLIP: άκρο της ακμής, MOVE: η αρχική θέση
+    Point q;       // FLIP: το άλλο άκρο της ακμής, MOVE: η νέα θέση
+    int strategy;  // INSERT: η στρατηγική (-1 αν το σημείο δεν προήλθε από στρατηγική)
+    Point face[3]; // INSERT: το αμβλυγώνιο τρίγωνο από το οποίο προήλθε το σημείο
+};
+
+struct State
+{
+    CDT cdt;
+    int obtuse_count;
+    int steiner_points;
+    std::vector<Point> steiner_locations;
+    std::vector<int> strategies;
+    std::vector<Operation> operations; // οι εισαγωγές από την αρχική κατάσταση (δεν συμμετέχουν στη σύγκριση)
+
+    // Εδώ χρησιμοποιούμε την compareStates για τη σύγκριση
+    bool operator==(const State &other) const
+    {
+        return obtuse_count == other.obtuse_count &&
+               steiner_points == other.steiner_points &&
+               steiner_locations == other.steiner_locations &&
+               strategies == other.strategies;
+    }
+};
+
+struct StateHash
+{
+    std::size_t operator()(const State &s) const
+    {
+        size_t hash_val = 0;
+        // Hash για obtuse_count, steiner_points, και άλλα χαρακτηριστικά
+        hash_val ^= hash<int>{}(s.obtuse_count) + 0x9e3779b9 + (hash_val << 6) + (hash_val >> 2);
+        hash_val ^= hash<int>{}(s.steiner_points) + 0x9e3779b9 + (hash_val << 6) + (hash_val >> 2);
+        for (const auto &loc : s.steiner_locations)
+        {
+            hash_val ^= hash<double>{}(loc.x()) + 0x9e3779b9 + (hash_val << 6) + (hash_val >> 2);
+            hash_val ^= hash<double>{}(loc.y()) + 0x9e3779b9 + (hash_val << 6) + (hash_val >> 2);
+        }
+        return hash_val;
+    }
+};
+
+// Υποψήφιο σημείο στρογγυλεμένο σε πλέγμα (snap_point), ώστε τα ίδια σημεία από γειτονικά τρίγωνα να ταυτίζονται
+// ακόμη κι αν διαφέρουν κατά σφάλματα στρογγύλευσης
+typedef pair<long long, long long> SnappedPoint;
+
+struct SnappedPointHash
+{
+    std::size_t operator()(const SnappedPoint &p) const
+    {
+        size_t hash_val = hash<long long>{}(p.first);
+        hash_val ^= hash<long long>{}(p.second) + 0x9e3779b9 + (hash_val << 6) + (hash_val >> 2);
+        return hash_val;
+    }
+};
+
+// Η καλύτερη λύση (obtuse_count, steiner_points) που έχει βρεθεί από όλα τα engines.
+// Τα δύο μεγέθη αποθηκεύονται σε ένα atomic ώστε η σύγκρισή τους να γίνεται λεξικογραφικά χωρίς lock.
+class Incumbent
+{
+public:
+    Incumbent() : packed(UINT64_MAX) {}
+
+    // Καταχωρεί τη λύση αν είναι καλύτερη από την τρέχουσα, επιστρέφει true αν έγινε
+    bool offer(int obtuse, int steiner)
+    {
+        uint64_t candidate = pack(obtuse, steiner);
+        uint64_t current = packed.load();
+        while (candidate < current)
+        {
+            if (packed.compare_exchange_weak(current, candidate))
+                return true;
+        }
+        return false;
+    }
+
+    // true αν η (obtuse, steiner) είναι ακόμη η καλύτερη λύση
+    bool holds(int obtuse, int steiner) const
+    {
+        return packed.load() == pack(obtuse, steiner);
+    }
+
+    // Ανάγνωση και των δύο μεγεθών από την ίδια τιμή
+    void load(int &obtuse, int &steiner) const
+    {
+        uint64_t value = packed.load();
+        obtuse = value >> 32;
+        steiner = value & 0xffffffffu;
+    }
+
+private:
+    static uint64_t pack(int obtuse, int steiner)
+    {
+        return (uint64_t(uint32_t(obtuse)) << 32) | uint32_t(steiner);
+    }
+
+    atomic<uint64_t> packed;
+};
+
+// Μαθαίνει ανά instance και ανά κλάση τριγώνου (classify_face) πόσο συχνά κάθε στρατηγική μειώνει τα αμβλυγώνια,
+// ώστε να δοκιμάζονται πρώτα οι πιο υποσχόμενες. Κοινός για όλα τα νήματα του portfolio. Οι μετρητές είναι atomic,
+// ώστε το order (μία φορά ανά αμβλυγώνιο τρίγωνο) να μη χρειάζεται lock. Μια ταξινόμηση μπορεί να δει μετρητές
+// λίγο πριν από ένα ταυτόχρονο update, που για έναν ευρετικό κανόνα δεν πειράζει.
+class StrategySelector
+{
+public:
+    static const int strategy_count = 5;
+    static const int class_count = 4;
+
+    StrategySelector();
+    vector<int> order(int face_class);
+    void update(int face_class, int strategy, bool success);
+    // Οι μετρητές ως επίπεδοι πίνακες [κλάση][στρατηγική], για τα checkpoints
+    void save(vector<int> &saved_attempts, vector<int> &saved_successes);
+    void restore(const vector<int> &saved_attempts, const vector<int> &saved_successes);
+
+private:
+    atomic<int> attempts[class_count][strategy_count];
+    atomic<int> successes[class_count][strategy_count];
+};
+
+// Κατάσταση της αναζήτησης σε ένα checkpoint (checkpoint.cpp). Οι καταστάσεις αποθηκεύονται ως οι αλλαγές από
+// την αρχική κατάσταση (όπως στο operation log) και ξαναχτίζονται με το rebuild_state.
+struct Checkpoint
+{
+    string engine;
+    string instance;                    // instance_fingerprint του instance στο οποίο γράφτηκε
+    vector<Operation> setup;            // οι αλλαγές πριν από την αναζήτηση (flips)
+    vector<Operation> best;             // η καλύτερη κατάσταση του engine
+    vector<vector<Operation>> frontier; // BFS: η ουρά, annealing: η τρέχουσα κατάσταση
+    string rng_state;
+    int iteration = 0;        // BFS: επαναλήψεις χωρίς βελτίωση, restarts: η επόμενη επανεκκίνηση
+    double temperature = 0.0; // annealing
+    int stalled_levels = 0;   // annealing
+    vector<int> selector_attempts;
+    vector<int> selector_successes;
+};
+
+// Περιοδική εγγραφή checkpoints από ένα engine (όχι στο portfolio)
+class Checkpointer
+{
+public:
+    Checkpointer(const string &filename, long long interval_ms, const string &engine, const string &instance, const vector<Operation> &setup,
+                 ostream *log);
+    bool due() const;
+    void save(Checkpoint &checkpoint, StrategySelector &selector);
+
+private:
+    string filename;
+    long long interval_ms;
+    string engine;
+    string instance;
+    vector<Operation> setup;
+    ostream *log;
+    chrono::steady_clock::time_point last;
+};
+
+// Στατιστικά ανά στρατηγική για όλη την εκτέλεση (όλα τα engines και νήματα). Οι μετρητές είναι atomic,
+// ώστε η καταγραφή να μη χρειάζεται lock.
+class StrategyStatistics
+{
+public:
+    StrategyStatistics();
+    void attempt(int strategy, long long elapsed_ns, bool in_domain);
+    void evaluated(int strategy, int delta);
+    void accepted(int strategy);
+    vector<StrategyReport> report() const;
+
+private:
+    atomic<long long> attempts[StrategySelector::strategy_count];
+    atomic<long long> out_of_domain[StrategySelector::strategy_count];
+    atomic<long long> evaluations[StrategySelector::strategy_count];
+    atomic<long long> delta_sum[StrategySelector::strategy_count];
+    atomic<long long> acceptances[StrategySelector::strategy_count];
+    atomic<long long> time_ns[StrategySelector::strategy_count];
+};
+
+// Χρονοσειρά σύγκλισης (SolverOptions::trace_file): δείγματα (elapsed_ms, iteration, best_obtuse, steiner_points,
+// frontier_size, rss_kb) σε CSV ή, αν το αρχείο τελειώνει σε .jsonl, σε JSON lines. Τα engines καλούν το iteration
+// σε κάθε επανάληψη, αλλά γράφεται δείγμα μόνο κάθε interval_ms ή όταν αλλάξει η καλύτερη λύση.
+class ConvergenceTrace
+{
+public:
+    ConvergenceTrace(const string &filename, long long interval_ms);
+    bool is_open() const;
+    void iteration(const Incumbent &incumbent, size_t frontier_size);
+    void finish(const Incumbent &incumbent);
+
+private:
+    void write(const Incumbent &incumbent, size_t frontier_size);
+
+    mutex lock;
+    ofstream file;
+    bool jsonl;
+    chrono::steady_clock::time_point start;
+    long long interval_ms;
+    atomic<long long> iterations;
+    atomic<long long> next_sample_ms;
+    atomic<int> last_obtuse;
+    atomic<int> last_steiner;
+};
+
+// Τρόπος αξιολόγησης των υποψήφιων Steiner points (SolverOptions::evaluation)
+enum EvaluationMode
+{
+    FULL_EVALUATION,      // δοκιμαστική εισαγωγή (ScratchCDT) και ακριβής καταμέτρηση
+    PREDICTED_EVALUATION, // πρόβλεψη από τη ζώνη σύγκρουσης, επαλήθευση μόνο για το σημείο που επιλέγεται
+    SUBMESH_EVALUATION    // εισαγωγή σε μικρό CDT γύρω από το τρίγωνο, επαλήθευση μόνο για το σημείο που επιλέγεται
+};
+
+// Δοκιμαστικό CDT ενός worker, ίσο με το CDT της τρέχουσας κατάστασης (parent). Κάθε δοκιμή εισάγει το σημείο,
+// μετράει τα αμβλυγώνια γύρω του και το αφαιρεί ξανά, οπότε ανά υποψήφιο δεν χτίζεται αντίγραφο ολόκληρου του
+// CDT ούτε μετριούνται όλα τα τρίγωνα. Τα αμβλυγώνια πριν από την εισαγωγή μετριούνται στο parent, οπότε το
+// αποτέλεσμα είναι ακριβές. Αν η αφαίρεση δεν επαναφέρει ακριβώς το parent (π.χ. ομοκυκλικά σημεία), το scratch
+// σημειώνεται ως stale και ξαναγίνεται αντίγραφο στην επόμενη δοκιμή.
+class ScratchCDT
+{
+public:
+    // Πρέπει να καλείται κάθε φορά που αλλάζει το parent, πριν από τις δοκιμές. Το αντίγραφο γίνεται στην
+    // πρώτη δοκιμή, οπότε δεν κοστίζει τίποτα αν δεν γίνει καμία.
+    void sync(const CDT &source);
+
+    // Τα αμβλυγώνια του parent μετά την εισαγωγή του p, με face το τρίγωνο του parent που περιέχει το p
+    int insertion_obtuse(const Point &p, Face_handle face, int parent_obtuse);
+
+private:
+    const CDT *parent = nullptr;
+    bool stale = true; // το cdt δεν είναι ακόμη αντίγραφο του parent
+    CDT cdt;
+    Face_handle hint; // τρίγωνο του cdt κοντά στην τελευταία δοκιμή, για το επόμενο locate
+};
+
+// Επίπεδο αντίγραφο ενός CDT για τους βρόχους που μόνο διαβάζουν την τριγωνοποίηση (καταμέτρηση, κλάσεις
+// τριγώνων, clusters αμβλυγώνιων, υποψήφια σημεία). Οι κορυφές και τα πεπερασμένα τρίγωνα αριθμούνται με int32
+// (στο info των handles), οι συντεταγμένες είναι σε πίνακες x/y και κάθε τρίγωνο κρατά τις κορυφές και τους
+// γείτονές του ως δείκτες, οπότε οι διασχίσεις δεν ακολουθούν τους pointers της CGAL. Κάθε worker έχει το δικό
+// του, χτισμένο από το cdt της κατάστασής του, και μετά από κάθε εισαγωγή στο cdt ενημερώνεται μόνο γύρω από
+// τη νέα κορυφή. Στα mirrors που ακολουθούν πολλές εισαγωγές οι κορυφές και τα τρίγωνα αριθμούνται κατά μήκος μιας
+// καμπύλης Hilbert, ώστε οι διασχίσεις με τη σειρά των δεικτών να περνούν από γειτονικά τρίγωνα.
+class MeshMirror
+{
+public:
+    // Αρίθμηση όλου του cdt από την αρχή, με τη σειρά των iterators της CGAL. Με ordered ακολουθεί το compact,
+    // που αξίζει μόνο για mirrors που ζουν πολλές εισαγωγές (greedy, annealing) και όχι για ένα build ανά κατάσταση.
+    void build(CDT &cdt, bool ordered);
+
+    // Νέα αρίθμηση κατά Hilbert χωρίς κενές θέσεις. Γίνεται και αυτόματα όταν τα τρίγωνα που προστέθηκαν στο
+    // τέλος από τις εισαγωγές γίνουν αρκετά.
+    void compact();
+
+    // Ενημέρωση μετά από v = cdt.insert(p): αλλάζουν μόνο τα τρίγωνα γύρω από τη v και οι γείτονές τους
+    void inserted(CDT &cdt, Vertex_handle v);
+
+    int obtuse_count() const
+    {
+        return obtuse;
+    }
+
+    // Τα αμβλυγώνια τρίγωνα με τη σειρά της αρίθμησης
+    vector<int32_t> obtuse_faces() const;
+
+    // Η κλάση του τριγώνου f (classify_face), -1 αν δεν είναι αμβλυγώνιο
+    int classify(int32_t f) const
+    {
+        return face_class[f];
+    }
+
+    Point point(int32_t f, int i) const
+    {
+        int32_t v = face_vertices[3 * f + i];
+        return Point(x[v], y[v]);
+    }
+
+    Face_handle handle(int32_t f) const
+    {
+        return face_handles[f];
+    }
+
+    // Το κέντρο βάρους του κυρτού περιβλήματος του cluster γύρω από το πρώτο αμβλυγώνιο τρίγωνο του cdt (στρατηγική 4).
+    // Δεν εξαρτάται από το τρίγωνο για το οποίο ζητείται, οπότε υπολογίζεται μία φορά ανά αλλαγή του cdt.
+    // Επιστρέφει false αν δεν υπάρχει αμβλυγώνιο τρίγωνο.
+    bool cluster_centroid(Point &centroid) const;
+
+private:
+    int32_t add_face(Face_handle f);
+    void remove_face(int32_t f);
+    void write_face(CDT &cdt, int32_t f);
+
+    CDT *source = nullptr;           // το cdt που ακολουθεί το mirror (από το τελευταίο build)
+    vector<double> x, y;             // συντεταγμένες των κορυφών
+    vector<int32_t> face_vertices;   // 3 ανά τρίγωνο
+    vector<int32_t> face_neighbors;  // 3 ανά τρίγωνο, απέναντι από την κορυφή i (-1: άπειρο τρίγωνο)
+    vector<int8_t> face_class;       // -1 για μη αμβλυγώνια τρίγωνα και ελεύθερες θέσεις
+    vector<Vertex_handle> vertex_handles;
+    vector<Face_handle> face_handles;
+    vector<int32_t> free_faces;      // θέσεις τριγώνων που έγιναν άπειρα
+    int32_t live_faces = 0;
+    int32_t appended = 0;            // τρίγωνα που προστέθηκαν στο τέλος μετά την τελευταία αρίθμηση
+    int obtuse = 0;
+    mutable bool cluster_valid = false;
+    mutable bool cluster_found = false;
+    mutable Point cluster;
+};
+
+// Μικρό ανεξάρτητο CDT με τα τρίγωνα γύρω από ένα τρίγωνο (extract_submesh)
+struct Submesh
+{
+    CDT cdt;
+    vector<Point> seeds;              // ένα σημείο στο εσωτερικό κάθε τριγώνου του submesh
+    set<pair<Point, Point>> boundary; // οι ακμές του ορίου, που είναι constraints στο cdt
+    set<Face_handle> inside;          // τα τρίγωνα του cdt που ανήκουν στο submesh
+    int obtuse_count;                 // αμβλυγώνια μέσα στο submesh
+};
+
+// Μόνιμα νήματα για τις παράλληλες αξιολογήσεις μέσα σε ένα engine (worker_pool.cpp), ώστε οι επαναλήψεις του
+// engine να μη δημιουργούν νέα νήματα κάθε φορά. Ο καλών δουλεύει κι αυτός, οπότε τα βοηθητικά νήματα είναι
+// threads - 1. Το parallel_for καλείται από ένα νήμα τη φορά.
+class WorkerPool
+{
+public:
+    explicit WorkerPool(unsigned threads);
+    ~WorkerPool();
+
+    unsigned size() const
+    {
+        return helpers.size() + 1;
+    }
+
+    // Καλεί το task(i) για κάθε i στο [0, count), μοιρασμένα στα νήματα, και επιστρέφει όταν τελειώσουν όλα
+    void parallel_for(size_t count, const function<void(size_t)> &task);
+
+private:
+    void work();
+    void drain();
+
+    vector<thread> helpers;
+    mutex lock;
+    condition_variable wake, done;
+    const function<void(size_t)> *task = nullptr;
+    size_t count = 0;
+    atomic<size_t> next;
+    unsigned active = 0;             // βοηθητικά νήματα που δεν έχουν τελειώσει την τρέχουσα δουλειά
+    unsigned long long generation = 0; // αυξάνεται σε κάθε parallel_for
+    bool stopping = false;
+};
+
+// Κοινό πλαίσιο για όλα τα engines αναζήτησης
+struct SearchContext
+{
+    Polygon_2 &region_boundary;
+    const SolverOptions &options;
+    const StopCondition &stop;
+    Incumbent &incumbent;
+    StrategySelector &selector;
+    StrategyStatistics &strategy_stats;
+    ConvergenceTrace *trace; // nullptr αν δεν ζητήθηκε trace
+    Checkpointer *checkpointer; // nullptr αν δεν ζητήθηκαν checkpoints
+    const Checkpoint *resume;   // το checkpoint από το οποίο συνεχίζει το engine (nullptr για νέα αναζήτηση)
+    EvaluationMode evaluation;
+    WorkerPool &workers; // νήματα για παράλληλες αξιολογήσεις μέσα σε ένα engine
+    bool prune; // κλάδεμα καταστάσεων που κυριαρχούνται από τον incumbent (portfolio)
+    function<void(const State &)> on_improvement;
+
+    // Ενημέρωση του incumbent και αναφορά αν η κατάσταση είναι η νέα καλύτερη λύση
+    void report(const State &state)
+    {
+        if (incumbent.offer(state.obtuse_count, state.steiner_points))
+            on_improvement(state);
+    }
+
+    // Μία επανάληψη του engine για το trace σύγκλισης. frontier_size: στο bfs οι καταστάσεις στην ουρά, στα greedy,
+    // restarts και annealing τα αμβλυγώνια τρίγωνα της τρέχουσας κατάστασης (οι υποψήφιες κινήσεις του βήματος).
+    void trace_iteration(size_t frontier_size)
+    {
+        if (trace)
+            trace->iteration(incumbent, frontier_size);
+    }
+
+    // Αν έχει έρθει η ώρα για checkpoint (το engine τότε συμπληρώνει την κατάστασή του και καλεί το checkpoint)
+    bool checkpoint_due() const
+    {
+        return checkpointer && checkpointer->due();
+    }
+
+    void checkpoint(Checkpoint &state)
+    {
+        checkpointer->save(state, selector);
+    }
+
+    // Μια κατάσταση δεν αξίζει να επεκταθεί αν ο incumbent δεν έχει αμβλυγώνια με λιγότερα ή ίσα Steiner points
+    // (η προσθήκη σημείων δεν μπορεί να τον ξεπεράσει), ή στο portfolio αν είναι χειρότερη και στα δύο μεγέθη
+    bool pruned(int obtuse, int steiner) const
+    {
+        int best_obtuse, best_steiner;
+        incumbent.load(best_obtuse, best_steiner);
+        if (best_obtuse == 0 && steiner >= best_steiner)
+            return true;
+        return prune && best_obtuse < obtuse && best_steiner <= steiner;
+    }
+};
+
+// Τύπος ενός engine αναζήτησης: ξεκινά από την αρχική κατάσταση και επιστρέφει την καλύτερη που βρήκε
+typedef State (*Engine)(const State &initial_state, SearchContext &context, mt19937 &rng);
+
+int is_obtuse_angle(Point &A, Point &B, Point &C);
+int is_obtuse_triangle(Point &a, Point &b, Point &c);
+int count_Obtuse_Angles(CDT &cdt);
+vector<Face_handle> find_obtuse_faces(CDT &cdt);
+bool is_inside_region(Polygon_2 &region_boundary, Point &p);
+Point project_point(Point &A, Point &B, Point &P);
+Polygon_2 find_convex_polygon_around_obtuse_triangle(CDT &cdt, Face_handle face);
+Point select_steiner_point(Point &a, Point &b, Point &c, int strategy, CDT &cdt, Polygon_2 region_boundary);
+Point select_steiner_point(Point &a, Point &b, Point &c, int strategy, const MeshMirror &mesh);
+bool propose_steiner_point(SearchContext &context, Point &a, Point &b, Point &c, int strategy, const MeshMirror &mesh, Point &steiner);
+Solution build_solution(const CDT &cdt, const InstancePoints &points, const Polygon_2 &region_boundary, int obtuse_count);
+bool compareStates(const State &a, const State &b);
+bool is_better_state(const State &a, const State &b);
+ostream &progress_log(ostream *log);
+
+// επιλογή στρατηγικής (strategy_selector.cpp)
+int classify_face(CDT &cdt, Face_handle face);
+
+// αξιολόγηση υποψήφιων σημείων (evaluation.cpp)
+EvaluationMode parse_evaluation_mode(const string &name);
+SnappedPoint snap_point(const Point &p);
+bool predict_insertion_delta(const CDT &cdt, const Point &p, int &delta);
+Submesh extract_submesh(const CDT &cdt, Face_handle face, int rings);
+bool submesh_insertion_delta(const Submesh &submesh, const Point &p, int &delta);
+bool estimate_insertion_delta(const SearchContext &context, const CDT &cdt, Face_handle face, const Point &p, int &delta);
+vector<int> estimate_insertion_deltas(const SearchContext &context, const CDT &cdt, const vector<Face_handle> &faces, const vector<Point> &candidates);
+int evaluate_candidate(const SearchContext &context, const CDT &cdt, ScratchCDT &scratch, int obtuse_count, Face_handle face, const Point &p);
+int verify_candidate(ScratchCDT &scratch, int obtuse_count, Face_handle face, const Point &p);
+void apply_candidate(const CDT &cdt, const Point &p, CDT &inserted);
+
+// operation log και replay (operation_log.cpp)
+Operation insert_operation(const Point &p, int strategy, Face_handle face);
+Operation insert_operation(const Point &p);
+Operation flip_operation(const Point &p, const Point &q);
+Operation move_operation(const Point &from, const Point &to);
+Operation remove_operation(const Point &p);
+string format_operation(const Operation &operation);
+bool parse_operation(const string &line, Operation &operation);
+bool write_operation_log(const string &filename, const vector<Operation> &operations);
+vector<Operation> read_operation_log(const string &filename);
+bool apply_operation(CDT &cdt, const Operation &operation);
+
+// checkpoints (checkpoint.cpp)
+bool write_checkpoint(const string &filename, const Checkpoint &checkpoint);
+Checkpoint read_checkpoint(const string &filename);
+string instance_fingerprint(const Instance &instance);
+State rebuild_state(const State &initial_state, const vector<Operation> &operations);
+string save_rng(const mt19937 &rng);
+void restore_rng(mt19937 &rng, const string &saved);
+
+// τοπικές βελτιώσεις (local_optimization.cpp)
+int flip_optimization(CDT &cdt, vector<Operation> *log = nullptr);
+Vertex_handle relocate_vertex(CDT &cdt, Vertex_handle v, const Point &q);
+vector<Point> steiner_removal(CDT &cdt, const InstancePoints &points, unsigned threads, const StopCondition &stop, vector<Operation> *log = nullptr);
+vector<pair<Point, Point>> steiner_relocation(CDT &cdt, const InstancePoints &points, const StopCondition &stop);
+
+// engines (triangulation.cpp, engines.cpp)
+State bfs_triangulation(const State &initial_state, SearchContext &context, mt19937 &rng);
+State greedy_triangulation(const State &initial_state, SearchContext &context, mt19937 &rng);
+State annealing_triangulation(const State &initial_state, SearchContext &context, mt19937 &rng);
+State restarts_triangulation(const State &initial_state, SearchContext &context, mt19937 &rng);
+Engine find_engine(const string &name);
+State portfolio_triangulation(const State &initial_state, SearchContext &context, unsigned threads);
+
+#endif // TRIANGULATION_INTERNAL_H
@@ -0,0 +1,432 @@
+#include <CGAL/Exact_predicates_exact_constructions_kernel.h>
+#include <CGAL/Exact_rational.h>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include "json.hpp"
+
+using json = nlohmann::json;
+using namespace std;
+
+// Οι συντεταγμένες των Steiner points μπορεί να είναι κλάσματα, οπότε τα σημεία κρατιούνται ακριβώς (EPECK)
+typedef CGAL::Exact_predicates_exact_constructions_kernel K;
+typedef K::FT FT;
+typedef K::Point_2 Point;
+
+// Ανεξάρτητος έλεγχος μιας λύσης πριν από την υποβολή. Ο γράφος ξαναχτίζεται μόνο από τα σημεία (αρχικά και
+// Steiner) και τα edges της λύσης, χωρίς CDT, και ελέγχεται ότι:
+//   - τα σημεία είναι διακριτά και οι ακμές έγκυρες, χωρίς διπλές ή επικαλυπτόμενες ακμές,
+//   - κάθε όψη εκτός από την εξωτερική είναι θετικά προσανατολισμένο τρίγωνο (V - E + F = 2),
+//   - το εξωτερικό σύνορο είναι ακριβώς το region_boundary,
+//   - κάθε ακμή του region_boundary και των additional_constraints υπάρχει (ίσως χωρισμένη από Steiner points).
+// Τότε η λύση είναι τριγωνοποίηση της περιοχής και μετράμε τα αμβλυγώνια τρίγωνα. Όλοι οι έλεγχοι γίνονται με τα
+// ακριβή predicates του kernel πάνω στις ακριβείς συντεταγμένες και το κόστος είναι O(n log n) από τις ταξινομήσεις.
+//
+// Χρήση: verify instance.json solution.json
+
+// Συντεταγμένη ως αριθμός ή ως κλάσμα "a/b" (και τα δύο επιτρέπονται στη μορφή του CG:SHOP). Ακέραιοι και
+// κλάσματα διαβάζονται ακριβώς, χωρίς στρογγύλευση σε double. Ένας δεκαδικός αριθμός κρατά την τιμή του double.
+static FT parse_coordinate(const json &value)
+{
+    if (value.is_number())
+        return FT(value.get<double>());
+    string text = value.get<string>();
+    if (text.find_first_of(".eE") != string::npos)
+        return FT(atof(text.c_str()));
+    size_t slash = text.find('/');
+    string numerator = text.substr(0, slash);
+    string denominator = slash == string::npos ? "1" : text.substr(slash + 1);
+    auto is_integer = [](const string &digits)
+    {
+        size_t start = !digits.empty() && (digits[0] == '-' || digits[0] == '+') ? 1 : 0;
+        return digits.size() > start && digits.find_first_not_of("0123456789", start) == string::npos;
+    };
+    if (!is_integer(numerator) || !is_integer(denominator) || denominator.find_first_not_of("+-0") == string::npos)
+        throw invalid_argument("Invalid coordinate '" + text + "'.");
+    if (numerator[0] == '+')
+        numerator = numerator.substr(1);
+    if (denominator[0] == '+')
+        denominator = denominator.substr(1);
+    return FT(CGAL::Exact_rational(numerator)) / FT(CGAL::Exact_rational(denominator));
+}
+
+// Μισή ακμή from -> to, με τις μισές ακμές κάθε κορυφής σε συνεχόμενες θέσεις και σε CCW σειρά γύρω της
+struct HalfEdge
+{
+    int from, to;
+};
+
+struct Verifier
+{
+    vector<Point> points;
+    vector<int> offsets;       // οι μισές ακμές της κορυφής v είναι οι [offsets[v], offsets[v + 1])
+    vector<HalfEdge> half_edges;
+    vector<int> by_target;     // οι μισές ακμές κάθε κορυφής ταξινομημένες κατά to, για την αναζήτηση
+    vector<int> twin;
+    vector<int> face;          // η όψη αριστερά κάθε μισής ακμής
+    vector<string> errors;
+
+    void error(const string &message)
+    {
+        errors.push_back(message);
+    }
+
+    // Η μισή ακμή u -> v, ή -1 αν δεν υπάρχει
+    int find_half_edge(int u, int v) const
+    {
+        auto begin = by_target.begin() + offsets[u];
+        auto end = by_target.begin() + offsets[u + 1];
+        auto it = lower_bound(begin, end, v, [&](int h, int target) { return half_edges[h].to < target; });
+        return it != end && half_edges[*it].to == v ? *it : -1;
+    }
+
+    // Η επόμενη μισή ακμή της όψης αριστερά της h: στην κορυφή to, η προηγούμενη της αντίθετης σε CCW σειρά
+    int next(int h) const
+    {
+        int t = twin[h];
+        int v = half_edges[t].from;
+        return t == offsets[v] ? offsets[v + 1] - 1 : t - 1;
+    }
+};
+
+// Ταξινόμηση των γειτόνων του center κατά γωνία, ξεκινώντας από τη θετική κατεύθυνση του x
+static bool angle_less(const Point &center, const Point &p, const Point &q)
+{
+    auto half = [&](const Point &r)
+    {
+        return (r.y() > center.y() || (r.y() == center.y() && r.x() > center.x())) ? 0 : 1;
+    };
+    int hp = half(p), hq = half(q);
+    if (hp != hq)
+        return hp < hq;
+    return CGAL::orientation(center, p, q) == CGAL::LEFT_TURN;
+}
+
+// Κατασκευή των μισών ακμών από τις ακμές της λύσης. Επιστρέφει false αν υπάρχουν επικαλυπτόμενες ακμές.
+static bool build_half_edges(Verifier &verifier, const vector<pair<int, int>> &edges)
+{
+    int n = verifier.points.size();
+    vector<int> degree(n + 1, 0);
+    for (const pair<int, int> &edge : edges)
+    {
+        degree[edge.first]++;
+        degree[edge.second]++;
+    }
+    bool overlaps = false;
+    verifier.offsets.assign(n + 1, 0);
+    for (int v = 0; v < n; ++v)
+    {
+        verifier.offsets[v + 1] = verifier.offsets[v] + degree[v];
+    }
+    verifier.half_edges.resize(2 * edges.size());
+    vector<int> fill(verifier.offsets.begin(), verifier.offsets.end() - 1);
+    for (const pair<int, int> &edge : edges)
+    {
+        verifier.half_edges[fill[edge.first]++] = {edge.first, edge.second};
+        verifier.half_edges[fill[edge.second]++] = {edge.second, edge.first};
+    }
+
+    for (int v = 0; v < n; ++v)
+    {
+        if (degree[v] == 0)
+        {
+            verifier.error("Point " + to_string(v) + " is not part of any edge.");
+            continue;
+        }
+        const Point &center = verifier.points[v];
+        auto begin = verifier.half_edges.begin() + verifier.offsets[v];
+        auto end = verifier.half_edges.begin() + verifier.offsets[v + 1];
+        sort(begin, end, [&](const HalfEdge &a, const HalfEdge &b)
+        {
+            return angle_less(center, verifier.points[a.to], verifier.points[b.to]);
+        });
+        // Δύο γείτονες στην ίδια κατεύθυνση σημαίνουν επικαλυπτόμενες ακμές
+        for (auto it = begin; it + 1 < end; ++it)
+        {
+            if (!angle_less(center, verifier.points[it->to], verifier.points[(it + 1)->to]))
+            {
+                overlaps = true;
+                verifier.error("Edges " + to_string(v) + "-" + to_string(it->to) + " and " + to_string(v) + "-" + to_string((it + 1)->to) + " overlap.");
+            }
+        }
+    }
+
+    verifier.by_target.resize(verifier.half_edges.size());
+    for (size_t h = 0; h < verifier.half_edges.size(); ++h)
+    {
+        verifier.by_target[h] = h;
+    }
+    for (int v = 0; v < n; ++v)
+    {
+        sort(verifier.by_target.begin() + verifier.offsets[v], verifier.by_target.begin() + verifier.offsets[v + 1],
+             [&](int a, int b) { return verifier.half_edges[a].to < verifier.half_edges[b].to; });
+    }
+    verifier.twin.assign(verifier.half_edges.size(), -1);
+    for (size_t h = 0; h < verifier.half_edges.size(); ++h)
+    {
+        verifier.twin[h] = verifier.find_half_edge(verifier.half_edges[h].to, verifier.half_edges[h].from);
+    }
+    return !overlaps;
+}
+
+// Οι όψεις του γράφου. Επιστρέφει την εξωτερική όψη (-1 αν δεν υπάρχει ακριβώς μία) και τα τρίγωνα στο triangles.
+static int trace_faces(Verifier &verifier, vector<int> &triangles, int &face_count)
+{
+    verifier.face.assign(verifier.half_edges.size(), -1);
+    face_count = 0;
+    int outer = -1;
+    int outer_count = 0;
+    for (size_t start = 0; start < verifier.half_edges.size(); ++start)
+    {
+        if (verifier.face[start] >= 0)
+            continue;
+        vector<int> cycle;
+        int h = start;
+        do
+        {
+            verifier.face[h] = face_count;
+            cycle.push_back(h);
+            h = verifier.next(h);
+        } while (h != (int)start && cycle.size() <= verifier.half_edges.size());
+
+        const Point &a = verifier.points[verifier.half_edges[cycle[0]].from];
+        if (cycle.size() == 3 &&
+            CGAL::orientation(a, verifier.points[verifier.half_edges[cycle[1]].from], verifier.points[verifier.half_edges[cycle[2]].from]) == CGAL::LEFT_TURN)
+        {
+            triangles.push_back(cycle[0]);
+        }
+        else
+        {
+            outer = face_count;
+            outer_count++;
+        }
+        face_count++;
+    }
+    if (outer_count != 1)
+    {
+        verifier.error("Expected one outer face and only triangles inside, found " + to_string(outer_count) + " faces that are not counterclockwise triangles.");
+        return -1;
+    }
+    return outer;
+}
+
+// Οι μισές ακμές της αλυσίδας από το a στο b (ακμές πάνω στο τμήμα ab). Επιστρέφει false αν κάποιο κομμάτι λείπει.
+static bool find_chain(const Verifier &verifier, int a, int b, vector<int> &chain)
+{
+    const Point &target = verifier.points[b];
+    int current = a;
+    while (current != b)
+    {
+        // Ο γείτονας στην κατεύθυνση του b, με δυαδική αναζήτηση στη CCW σειρά
+        const Point &center = verifier.points[current];
+        if (center == target)
+            return false;
+        auto begin = verifier.half_edges.begin() + verifier.offsets[current];
+        auto end = verifier.half_edges.begin() + verifier.offsets[current + 1];
+        auto it = lower_bound(begin, end, target, [&](const HalfEdge &h, const Point &q)
+        {
+            return angle_less(center, verifier.points[h.to], q);
+        });
+        if (it == end || angle_less(center, target, verifier.points[it->to]) ||
+            !CGAL::collinear_are_ordered_along_line(center, verifier.points[it->to], target))
+            return false;
+        chain.push_back(it - verifier.half_edges.begin());
+        current = it->to;
+    }
+    return true;
+}
+
+static bool is_obtuse(const Point &a, const Point &b, const Point &c)
+{
+    return CGAL::angle(a, b, c) == CGAL::OBTUSE || CGAL::angle(b, c, a) == CGAL::OBTUSE || CGAL::angle(c, a, b) == CGAL::OBTUSE;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        cerr << "Usage: " << argv[0] << " instance.json solution.json" << endl;
+        return 2;
+    }
+
+    json instance, solution;
+    {
+        ifstream instance_file(argv[1]), solution_file(argv[2]);
+        if (!instance_file.is_open() || !solution_file.is_open())
+        {
+            cerr << "Error: Could not open the file " << (instance_file.is_open() ? argv[2] : argv[1]) << endl;
+            return 2;
+        }
+        try
+        {
+            instance_file >> instance;
+            solution_file >> solution;
+        }
+        catch (const json::exception &error)
+        {
+            cerr << "Error: " << error.what() << endl;
+            return 2;
+        }
+    }
+
+    Verifier verifier;
+    vector<int> region_boundary;
+    vector<pair<int, int>> constraints;
+    vector<pair<int, int>> edges;
+    try
+    {
+        vector<double> points_x = instance.at("points_x").get<vector<double>>();
+        vector<double> points_y = instance.at("points_y").get<vector<double>>();
+        region_boundary = instance.at("region_boundary").get<vector<int>>();
+        constraints = instance.at("additional_constraints").get<vector<pair<int, int>>>();
+        for (size_t i = 0; i < points_x.size() && i < points_y.size(); ++i)
+        {
+            verifier.points.push_back(Point(points_x[i], points_y[i]));
+        }
+        const json &steiner_x = solution.at("steiner_points_x");
+        const json &steiner_y = solution.at("steiner_points_y");
+        if (steiner_x.size() != steiner_y.size())
+            verifier.error("steiner_points_x and steiner_points_y have different lengths.");
+        for (size_t i = 0; i < steiner_x.size() && i < steiner_y.size(); ++i)
+        {
+            verifier.points.push_back(Point(parse_coordinate(steiner_x[i]), parse_coordinate(steiner_y[i])));
+        }
+        edges = solution.at("edges").get<vector<pair<int, int>>>();
+        if (instance.value("instance_uid", string()) != solution.value("instance_uid", string()))
+            verifier.error("The solution is for instance '" + solution.value("instance_uid", string()) + "', not '" + instance.value("instance_uid", string()) + "'.");
+    }
+    catch (const json::exception &error)
+    {
+        cerr << "Error: " << error.what() << endl;
+        return 2;
+    }
+    catch (const invalid_argument &error)
+    {
+        cerr << "Error: " << error.what() << endl;
+        return 2;
+    }
+    int n = verifier.points.size();
+    int original = n - (int)solution["steiner_points_x"].size();
+    cout << "Points: " << original << " original, " << n - original << " Steiner; edges: " << edges.size() << endl;
+
+    // Διακριτά σημεία
+    {
+        vector<int> order(n);
+        for (int i = 0; i < n; ++i)
+        {
+            order[i] = i;
+        }
+        sort(order.begin(), order.end(), [&](int a, int b) { return verifier.points[a] < verifier.points[b]; });
+        for (int i = 0; i + 1 < n; ++i)
+        {
+            if (verifier.points[order[i]] == verifier.points[order[i + 1]])
+                verifier.error("Points " + to_string(order[i]) + " and " + to_string(order[i + 1]) + " coincide.");
+        }
+    }
+
+    // Έγκυρες και μοναδικές ακμές
+    for (pair<int, int> &edge : edges)
+    {
+        if (edge.first < 0 || edge.first >= n || edge.second < 0 || edge.second >= n || edge.first == edge.second)
+        {
+            cerr << "Error: invalid edge " << edge.first << "-" << edge.second << endl;
+            return 1;
+        }
+        if (edge.first > edge.second)
+            swap(edge.first, edge.second);
+    }
+    sort(edges.begin(), edges.end());
+    if (adjacent_find(edges.begin(), edges.end()) != edges.end())
+    {
+        verifier.error("Duplicate edges in the solution.");
+        edges.erase(unique(edges.begin(), edges.end()), edges.end());
+    }
+    for (int v : region_boundary)
+    {
+        if (v < 0 || v >= original)
+        {
+            cerr << "Error: invalid region boundary vertex " << v << endl;
+            return 1;
+        }
+    }
+    for (const pair<int, int> &constraint : constraints)
+    {
+        if (constraint.first < 0 || constraint.first >= original || constraint.second < 0 || constraint.second >= original)
+        {
+            cerr << "Error: invalid constraint " << constraint.first << "-" << constraint.second << endl;
+            return 1;
+        }
+    }
+
+    // Οι επικαλύψεις κάνουν τη σειρά γύρω από τις κορυφές (και άρα τις όψεις) ασαφή, οπότε τότε δεν ελέγχουμε όψεις
+    vector<int> triangles;
+    int face_count = 0;
+    int outer = -1;
+    if (build_half_edges(verifier, edges))
+    {
+        outer = trace_faces(verifier, triangles, face_count);
+        if (n - (int)edges.size() + face_count != 2)
+            verifier.error("The edges do not form a connected planar subdivision (V - E + F = " + to_string(n - (int)edges.size() + face_count) + ").");
+    }
+
+    // Το region_boundary και τα constraints πρέπει να υπάρχουν ως αλυσίδες ακμών. Το εξωτερικό σύνορο πρέπει να είναι
+    // ακριβώς οι αλυσίδες του region_boundary, μία φορά η καθεμία.
+    if (outer >= 0)
+    {
+        int outer_length = count(verifier.face.begin(), verifier.face.end(), outer);
+        int boundary_length = 0;
+        for (size_t i = 0; i < region_boundary.size(); ++i)
+        {
+            int a = region_boundary[i], b = region_boundary[(i + 1) % region_boundary.size()];
+            vector<int> chain;
+            if (!find_chain(verifier, a, b, chain))
+            {
+                verifier.error("Region boundary edge " + to_string(a) + "-" + to_string(b) + " is missing.");
+                continue;
+            }
+            for (int h : chain)
+            {
+                if (verifier.face[h] != outer && verifier.face[verifier.twin[h]] != outer)
+                    verifier.error("Region boundary edge " + to_string(verifier.half_edges[h].from) + "-" + to_string(verifier.half_edges[h].to) + " is not on the outer boundary.");
+            }
+            boundary_length += chain.size();
+        }
+        if (outer_length != boundary_length)
+            verifier.error("The outer boundary has " + to_string(outer_length) + " edges, the region boundary " + to_string(boundary_length) + ".");
+    }
+    for (const pair<int, int> &constraint : constraints)
+    {
+        vector<int> chain;
+        if (!find_chain(verifier, constraint.first, constraint.second, chain))
+            verifier.error("Constraint " + to_string(constraint.first) + "-" + to_string(constraint.second) + " is missing.");
+    }
+
+    int obtuse = 0;
+    for (int h : triangles)
+    {
+        const HalfEdge &e = verifier.half_edges[h];
+        int c = verifier.half_edges[verifier.next(h)].to;
+        if (is_obtuse(verifier.points[e.from], verifier.points[e.to], verifier.points[c]))
+            obtuse++;
+    }
+
+    const size_t max_errors = 20;
+    for (size_t i = 0; i < verifier.errors.size() && i < max_errors; ++i)
+    {
+        cerr << "Error: " << verifier.errors[i] << endl;
+    }
+    if (verifier.errors.size() > max_errors)
+        cerr << "... and " << verifier.errors.size() - max_errors << " more errors" << endl;
+    if (!verifier.errors.empty())
+    {
+        cout << "INVALID" << endl;
+        return 1;
+    }
+    cout << "Triangles: " << triangles.size() << ", obtuse: " << obtuse << endl;
+    cout << "VALID" << endl;
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include "triangulation_internal.h"
+
+// Μόνιμα νήματα για παράλληλες αξιολογήσεις (βλ. WorkerPool)
+
+/////////////////////////////////////////////////////////
+
+WorkerPool::WorkerPool(unsigned threads) : next(0)
+{
+    for (unsigned t = 1; t < threads; ++t)
+    {
+        helpers.emplace_back(&WorkerPool::work, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (thread &helper : helpers)
+    {
+        helper.join();
+    }
+}
+
+// Κάθε νήμα παίρνει τον επόμενο ελεύθερο δείκτη, οπότε τα αργά υποψήφια δεν καθυστερούν τα υπόλοιπα νήματα
+void WorkerPool::drain()
+{
+    for (size_t i = next++; i < count; i = next++)
+    {
+        (*task)(i);
+    }
+}
+
+void WorkerPool::parallel_for(size_t count, const function<void(size_t)> &task)
+{
+    if (helpers.empty() || count < 2)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            task(i);
+        }
+        return;
+    }
+    {
+        lock_guard<mutex> guard(lock);
+        this->task = &task;
+        this->count = count;
+        next = 0;
+        active = helpers.size();
+        generation++;
+    }
+    wake.notify_all();
+    drain();
+    // Τα βοηθητικά νήματα μπορεί να εκτελούν ακόμη το τελευταίο task τους
+    unique_lock<mutex> guard(lock);
+    done.wait(guard, [&]()
+              { return active == 0; });
+    this->task = nullptr;
+}
+
+void WorkerPool::work()
+{
+    unsigned long long seen = 0;
+    for (;;)
+    {
+        {
+            unique_lock<mutex> guard(lock);
+            wake.wait(guard, [&]()
+                      { return stopping || generation != seen; });
+            if (stopping)
+                return;
+            seen = generation;
+        }
+        drain();
+        lock_guard<mutex> guard(lock);
+        if (--active == 0)
+            done.notify_one();
+    }
+}